@@ -0,0 +1,109 @@
+/*Date:    17Oct2026Sat 17:50
+//File:    peg_command.c
+//Desc:    Perfect hash of the command words of peg_command.h.
+*/
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include <string.h>
+#include "peg_command.h"
+
+#define COMMAND_SLOTS 64
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+struct Command_Word
+{
+ char          Word[COMMAND_LONGEST + 1];
+ unsigned char Length,  /*0 for an empty slot*/
+               Command; /*enum Peg_Command*/
+};
+
+
+/*----------------------------
+//Global Variable Declarations
+----------------------------*/
+/*Slot of a word = (length + value of its first + value of its last
+  character) & 63. The values were picked by a random search until all words
+  landed in different slots, adding a word means searching again*/
+static const unsigned char Command_Value[256] =
+{
+ ['1'] = 11, ['2'] = 21, ['3'] =  0, ['4'] = 38, ['5'] = 62, ['6'] = 29,
+ ['?'] = 15, ['b'] = 29, ['d'] = 10, ['e'] = 48, ['h'] =  9, ['i'] = 59,
+ ['j'] = 45, ['k'] = 16, ['l'] = 42, ['m'] = 49, ['n'] = 28, ['o'] = 48,
+ ['p'] = 39, ['q'] =  4, ['r'] = 10, ['s'] =  5, ['t'] = 17, ['u'] = 19,
+ ['w'] = 33
+};
+
+static const struct Command_Word Command_Table[COMMAND_SLOTS] =
+{
+ [ 0] = {"new",           3, Command_New},
+ [ 1] = {"3",             1, Command_Option_3},
+ [ 5] = {"exit",          4, Command_Quit},
+ [ 7] = {"undo",          4, Command_Undo},
+ [ 8] = {"menu",          4, Command_Menu},
+ [ 9] = {"q",             1, Command_Quit},
+ [11] = {"s",             1, Command_Select},
+ [12] = {"instructions", 12, Command_Help},
+ [13] = {"4",             1, Command_Option_4},
+ [17] = {"main",          4, Command_Main},
+ [18] = {"settings",      8, Command_Settings},
+ [19] = {"h",             1, Command_Left},
+ [21] = {"l",             1, Command_Right},
+ [22] = {"count",         5, Command_Count},
+ [23] = {"1",             1, Command_Option_1},
+ [25] = {"quit",          4, Command_Quit},
+ [27] = {"j",             1, Command_Down},
+ [28] = {"select",        6, Command_Select},
+ [30] = {"hint",          4, Command_Solve},
+ [31] = {"?",             1, Command_Help},
+ [32] = {"right",         5, Command_Right},
+ [33] = {"k",             1, Command_Up},
+ [34] = {"restart",       7, Command_New},
+ [42] = {"down",          4, Command_Down},
+ [43] = {"2",             1, Command_Option_2},
+ [44] = {"board",         5, Command_Board},
+ [47] = {"info",          4, Command_Info},
+ [49] = {"tab",           3, Command_Tab},
+ [52] = {"help",          4, Command_Help},
+ [56] = {"load",          4, Command_Load},
+ [57] = {"save",          4, Command_Save},
+ [58] = {"solve",         5, Command_Solve},
+ [59] = {"6",             1, Command_Option_6},
+ [60] = {"up",            2, Command_Up},
+ [61] = {"5",             1, Command_Option_5},
+ [62] = {"redo",          4, Command_Redo},
+ [63] = {"left",          4, Command_Left}
+};
+
+
+/*--------------------
+//Function Definitions (Implementation)
+--------------------*/
+
+
+/*FUNCTION:*/
+enum Peg_Command Command_Token(const char *Text, size_t Length)
+{
+ /*Text is Length bytes, it need not end in a NUL. Anything that is not a
+   command word of any length is Command_Error*/
+
+ const struct Command_Word *Slot;
+
+
+ if (Length == 0 || Length > COMMAND_LONGEST)
+   return Command_Error;
+
+ Slot = &Command_Table[(Length + Command_Value[(unsigned char) Text[0]] +
+                        Command_Value[(unsigned char) Text[Length - 1]]) &
+                       (COMMAND_SLOTS - 1)];
+
+ if (Slot->Length != Length || memcmp(Slot->Word, Text, Length) != 0)
+   return Command_Error;
+
+ return (enum Peg_Command) Slot->Command;
+}
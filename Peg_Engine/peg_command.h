@@ -0,0 +1,43 @@
+/*Date:    17Oct2026Sat 17:50
+//File:    peg_command.h
+//Desc:    The words typed at the Command: prompt & sent to the server, turned
+           into 1 enum Peg_Command each by a perfect hash: 1 table probe & 1
+           memcmp per command, whatever the number of words. Aliases map to
+           the same command as the word they stand for:
+            k up, j down, h left, l right (vi keys), s select, ? instructions
+            help, q exit quit, hint solve, restart new
+*/
+
+
+#ifndef PEG_COMMAND_H
+#define PEG_COMMAND_H
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include <stddef.h>
+
+#define COMMAND_LONGEST 12 /*bytes of the longest word, "instructions"*/
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+/*Option_1 to Option_6 are the menu numbers & equal 1 to 6*/
+enum Peg_Command {Command_Menu, Command_Option_1, Command_Option_2,
+                  Command_Option_3, Command_Option_4, Command_Option_5,
+                  Command_Option_6, Command_Up, Command_Down, Command_Right,
+                  Command_Left, Command_Select, Command_Tab, Command_Help,
+                  Command_Quit, Command_Main, Command_Info, Command_New,
+                  Command_Load, Command_Save, Command_Settings, Command_Solve,
+                  Command_Undo, Command_Redo, Command_Board, Command_Count,
+                  Command_Error};
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+enum Peg_Command Command_Token(const char *Text, size_t Length);
+
+#endif
@@ -0,0 +1,611 @@
+/*Date:    17Oct2026Sat 23:15
+//File:    peg_count.c
+//Desc:    Solution counting of peg_count.h. The count of a position is
+           found depth first over the jumps of Bitboard_Legal_Jumps with the
+           pagoda sums riding down like in the solver, & stored in the memo
+           table on the way back up. 128 bit arithmetic is done on 2 words in
+           plain C, tcc has no 128 bit integer.
+*/
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "peg_count.h"
+#include "peg_database.h"
+#include "peg_pagoda.h"
+
+#define PROBE_LENGTH      8
+#define NODE_BATCH        4096 /*nodes counted locally before the shared add*/
+#define COUNT_TASKS       16   /*tasks per thread the tree is split into*/
+#define COUNT_SPLIT_DEPTH 6    /*levels at most, the weights stay 64 bit*/
+#define COUNT_BUSY        ((uint64_t) 1 << 63) /*key of a slot being
+                                                 written, no board has it*/
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+/*1 memo slot, Key 0 is empty*/
+struct Count_Entry
+{
+ uint64_t            Key;
+ struct Count_Number Count;
+};
+
+/*1 board of the split, Weight the jump orders from the root that reach it*/
+struct Count_Task
+{
+ uint64_t            Key,
+                     Weight;
+ struct Count_Number Count;
+};
+
+struct Counter
+{
+ struct Count_Task *Tasks;
+ int                Task_Count,
+                    Next;       /*atomic, the next task to take*/
+ uint64_t           Node_Limit, /*0 for no limit*/
+                    Nodes;      /*atomic*/
+ int                Stop;       /*atomic, 1 once the limit is passed*/
+};
+
+struct Count_Worker
+{
+ struct Counter *C;
+ pthread_t       Thread;
+ int             Running;       /*1 when Thread was started*/
+ uint64_t        Nodes;         /*not yet added to C->Nodes*/
+};
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+static void               *Count_Run(void *Argument);
+static struct Count_Number Count_Search(struct Count_Worker *W,
+                                        struct Bitboard Pegs,
+                                        struct Pagoda_Sums Sums);
+static void                Count_Nodes(struct Count_Worker *W);
+static int                 Count_Split(struct Counter *C, struct Bitboard Pegs,
+                                       int Threads);
+static int                 Memo_Lookup(uint64_t Key,
+                                       struct Count_Number *Count);
+static void                Memo_Insert(uint64_t Key, struct Count_Number Count);
+static int                 Dead_Lookup(uint64_t Key);
+static void                Dead_Insert(uint64_t Key);
+static struct Count_Number Count_Add(struct Count_Number A,
+                                     struct Count_Number B);
+static struct Count_Number Count_Multiply(struct Count_Number A,
+                                          uint64_t Weight);
+static int                 Task_Compare(const void *A, const void *B);
+
+
+/*----------------------------
+//Global Variable Declarations
+----------------------------*/
+static struct Count_Entry *Count_Table; /*kept between calls, see Count_Free*/
+static uint64_t           *Dead_Table;  /*keys of the boards that count 0*/
+
+static const struct Count_Number Count_Zero = {0, 0},
+                                 Count_One  = {1, 0},
+                                 Count_Full = {UINT64_MAX, UINT64_MAX};
+
+
+/*--------------------
+//Function Definitions (Implementation)
+--------------------*/
+
+
+/*FUNCTION:*/
+int Count_Solutions(struct Bitboard Pegs, int Threads, uint64_t Node_Limit,
+                    struct Count_Result *Result)
+{
+ /*Library entry point. Counts with Threads threads, the calling thread
+   being 1 of them, & returns Result->Counted. Not reentrant, every call
+   shares the memo table*/
+
+ struct Counter       C;
+ struct Count_Worker *Workers;
+ int                  Index;
+
+
+ Result->Counted   = 1;
+ Result->Solutions = Count_Zero;
+ Result->Nodes     = 0;
+
+ if (Threads < 1) Threads = 1;
+
+ Symmetry_Init();
+ Pagoda_Init();
+
+ Pegs = Bitboard_And(Pegs, Valid_Holes);
+ if (Bitboard_Is_Empty(Pegs) || Position_Class_Lost(Pegs))
+   return 1;
+
+ if (Count_Table == NULL)
+   Count_Table = calloc((size_t) 1 << COUNT_TABLE_BITS,
+                        sizeof(struct Count_Entry));
+ if (Dead_Table == NULL)
+   Dead_Table = calloc((size_t) 1 << COUNT_DEAD_BITS, sizeof(uint64_t));
+
+ memset(&C, 0, sizeof(C));
+ C.Node_Limit = Node_Limit;
+ Workers      = calloc(Threads, sizeof(struct Count_Worker));
+
+ if (Count_Table == NULL || Dead_Table == NULL || Workers == NULL ||
+     !Count_Split(&C, Pegs, Threads))
+ {
+  free(Workers);
+  free(C.Tasks);
+  Result->Counted = -1;
+  return -1;
+ }
+
+ /*Worker 0 is the calling thread*/
+ for (Index = 0; Index < Threads; Index++)
+    Workers[Index].C = &C;
+
+ for (Index = 1; Index < Threads; Index++)
+    Workers[Index].Running = pthread_create(&Workers[Index].Thread, NULL,
+                                            Count_Run, &Workers[Index]) == 0;
+
+ Count_Run(&Workers[0]);
+
+ for (Index = 1; Index < Threads; Index++)
+    if (Workers[Index].Running)
+      pthread_join(Workers[Index].Thread, NULL);
+
+ if (C.Stop)
+   Result->Counted = -1;
+ else
+ {
+  for (Index = 0; Index < C.Task_Count; Index++)
+     Result->Solutions = Count_Add(Result->Solutions,
+                                   Count_Multiply(C.Tasks[Index].Count,
+                                                  C.Tasks[Index].Weight));
+
+  if (Result->Solutions.lo == UINT64_MAX && Result->Solutions.hi == UINT64_MAX)
+    Result->Counted = 0;
+ }
+
+ Result->Nodes = C.Nodes;
+
+ free(Workers);
+ free(C.Tasks);
+ return Result->Counted;
+}
+
+
+/*FUNCTION:*/
+char *Count_Format(struct Count_Number Number, char Text[COUNT_DIGITS])
+{
+ /*Number in decimal, divided by 10 a 32 bit limb at a time from the top.
+   Returns Text*/
+
+ uint32_t Limb[4];
+ uint64_t Rest;
+ char     Digits[COUNT_DIGITS];
+ int      Length = 0, Index, Nonzero;
+
+
+ Limb[0] = (uint32_t) (Number.hi >> 32);
+ Limb[1] = (uint32_t) Number.hi;
+ Limb[2] = (uint32_t) (Number.lo >> 32);
+ Limb[3] = (uint32_t) Number.lo;
+
+ do
+ {
+  for (Rest = 0, Nonzero = 0, Index = 0; Index < 4; Index++)
+  {
+   Rest        = Rest << 32 | Limb[Index];
+   Limb[Index] = (uint32_t) (Rest / 10);
+   Rest       %= 10;
+   Nonzero    |= Limb[Index] != 0;
+  }
+
+  Digits[Length++] = (char) ('0' + Rest);
+ }
+ while (Nonzero);
+
+ for (Index = 0; Index < Length; Index++)
+    Text[Index] = Digits[Length - 1 - Index];
+ Text[Length] = '\0';
+
+ return Text;
+}
+
+
+/*FUNCTION:*/
+void Count_Free(void)
+{
+ /*Releases the memo tables, the next count starts cold*/
+
+ free(Count_Table);
+ free(Dead_Table);
+ Count_Table = NULL;
+ Dead_Table  = NULL;
+}
+
+
+/*FUNCTION:*/
+static void *Count_Run(void *Argument)
+{
+ /*Counts tasks until none is left or the limit is passed*/
+
+ struct Count_Worker *W = Argument;
+ struct Counter      *C = W->C;
+ struct Bitboard      Pegs;
+ int                  Task;
+
+
+ while (!__atomic_load_n(&C->Stop, __ATOMIC_RELAXED) &&
+        (Task = __atomic_fetch_add(&C->Next, 1, __ATOMIC_RELAXED)) <
+        C->Task_Count)
+ {
+  Pegs = Bitboard_Unpack(C->Tasks[Task].Key);
+  C->Tasks[Task].Count = Count_Search(W, Pegs, Pagoda_Evaluate(Pegs));
+ }
+
+ Count_Nodes(W);
+ return NULL;
+}
+
+
+/*FUNCTION:*/
+static struct Count_Number Count_Search(struct Count_Worker *W,
+                                        struct Bitboard Pegs,
+                                        struct Pagoda_Sums Sums)
+{
+ /*Number of winning jump orders from Pegs, whose pagoda sums are Sums. Once
+   C->Stop is set the counts coming back are not complete & nothing more is
+   stored*/
+
+ struct Counter     *C = W->C;
+ struct Jump_Masks   Jumps;
+ struct Bitboard     Origins;
+ struct Count_Number Total = Count_Zero;
+ uint64_t            Key;
+ int                 Direction, From, Beads;
+
+
+ Beads = Bitboard_Count(Pegs);
+ if (Beads == 1)
+   return Bitboard_Is_Won(Pegs) ? Count_One : Count_Zero;
+
+ if (Pagoda_Lost(Sums, Beads) || Database_Lookup(Pegs) == 0)
+   return Count_Zero;
+
+ Key = Symmetry_Canonical(Bitboard_Pack(Pegs));
+ if (Dead_Lookup(Key) || Memo_Lookup(Key, &Total))
+   return Total;
+
+ if (++W->Nodes >= NODE_BATCH)
+   Count_Nodes(W);
+
+ if (__atomic_load_n(&C->Stop, __ATOMIC_RELAXED))
+   return Count_Zero;
+
+ Bitboard_Legal_Jumps(Pegs, &Jumps);
+
+ for (Direction = Jump_Up; Direction < JUMP_DIRECTIONS; Direction++)
+ {
+  Origins = Jumps.From[Direction];
+
+  while (!Bitboard_Is_Empty(Origins))
+  {
+   From  = Bitboard_Pop(&Origins);
+   Total = Count_Add(Total, Count_Search(W, Bitboard_Toggle(Pegs, From,
+                                              From + Jump_Offset[Direction],
+                                              From + 2 * Jump_Offset[Direction]),
+                                         Pagoda_Jump(Sums, From, Direction)));
+  }
+ }
+
+ if (__atomic_load_n(&C->Stop, __ATOMIC_RELAXED))
+   return Total;
+
+ if (Total.lo == 0 && Total.hi == 0)
+   Dead_Insert(Key);
+ else Memo_Insert(Key, Total);
+
+ return Total;
+}
+
+
+/*FUNCTION:*/
+static void Count_Nodes(struct Count_Worker *W)
+{
+ /*Adds the locally counted nodes to the shared total & enforces the limit*/
+
+ struct Counter *C = W->C;
+ uint64_t        Total;
+
+
+ Total    = __atomic_add_fetch(&C->Nodes, W->Nodes, __ATOMIC_RELAXED);
+ W->Nodes = 0;
+
+ if (C->Node_Limit && Total > C->Node_Limit)
+   __atomic_store_n(&C->Stop, 1, __ATOMIC_RELAXED);
+}
+
+
+/*FUNCTION:*/
+static int Count_Split(struct Counter *C, struct Bitboard Pegs, int Threads)
+{
+ /*The tasks of the count: the root alone for 1 thread, else level by level
+   the distinct canonical boards a jump below the last level with the
+   weights of their parents summed, until there are COUNT_TASKS per thread.
+   A child the pagodas cut is left out, it counts 0. Returns 0 when memory
+   runs out*/
+
+ struct Count_Task *Level, *Next;
+ struct Jump_Masks  Jumps;
+ struct Bitboard    Board, Origins, Child;
+ int                Count = 1, Depth, Index, Kept, Direction, From,
+                    Beads = Bitboard_Count(Pegs);
+
+
+ if ((Level = malloc(sizeof(struct Count_Task))) == NULL)
+   return 0;
+
+ Level[0].Key    = Symmetry_Canonical(Bitboard_Pack(Pegs));
+ Level[0].Weight = 1;
+
+ for (Depth = 0; Threads > 1 && Count > 0 && Count < Threads * COUNT_TASKS &&
+                 Depth < COUNT_SPLIT_DEPTH && Beads > 2; Depth++, Beads--)
+ {
+  if ((Next = malloc((size_t) Count * JUMP_DIRECTIONS * BOARD_HOLES *
+                     sizeof(struct Count_Task))) == NULL)
+  {
+   free(Level);
+   return 0;
+  }
+
+  for (Kept = 0, Index = 0; Index < Count; Index++)
+  {
+   Board = Bitboard_Unpack(Level[Index].Key);
+   Bitboard_Legal_Jumps(Board, &Jumps);
+
+   for (Direction = Jump_Up; Direction < JUMP_DIRECTIONS; Direction++)
+   {
+    Origins = Jumps.From[Direction];
+
+    while (!Bitboard_Is_Empty(Origins))
+    {
+     From  = Bitboard_Pop(&Origins);
+     Child = Bitboard_Toggle(Board, From, From + Jump_Offset[Direction],
+                             From + 2 * Jump_Offset[Direction]);
+     if (Pagoda_Lost(Pagoda_Evaluate(Child), Beads - 1))
+       continue;
+
+     Next[Kept].Key      = Symmetry_Canonical(Bitboard_Pack(Child));
+     Next[Kept++].Weight = Level[Index].Weight;
+    }
+   }
+  }
+
+  /*Equal boards are merged, their weights added*/
+  qsort(Next, Kept, sizeof(struct Count_Task), Task_Compare);
+  for (Count = 0, Index = 0; Index < Kept; Index++)
+     if (Count > 0 && Next[Count - 1].Key == Next[Index].Key)
+       Next[Count - 1].Weight += Next[Index].Weight;
+     else Next[Count++] = Next[Index];
+
+  free(Level);
+  Level = Next;
+ }
+
+ for (Index = 0; Index < Count; Index++)
+    Level[Index].Count = Count_Zero;
+
+ C->Tasks      = Level;
+ C->Task_Count = Count;
+ return 1;
+}
+
+
+/*FUNCTION:*/
+static int Memo_Lookup(uint64_t Key, struct Count_Number *Count)
+{
+ /*The key is read before & after the count, a slot rewritten in between
+   reads as a miss*/
+
+ const uint64_t      Mask = ((uint64_t) 1 << COUNT_TABLE_BITS) - 1;
+ uint64_t            Slot = (Key * 0x9e3779b97f4a7c15ULL) >>
+                            (64 - COUNT_TABLE_BITS),
+                     Entry;
+ struct Count_Entry *Found;
+ int                 Probe;
+
+
+ for (Probe = 0; Probe < PROBE_LENGTH; Probe++)
+ {
+  Found = &Count_Table[(Slot + Probe) & Mask];
+  Entry = __atomic_load_n(&Found->Key, __ATOMIC_ACQUIRE);
+
+  if (Entry == Key)
+  {
+   Count->lo = __atomic_load_n(&Found->Count.lo, __ATOMIC_RELAXED);
+   Count->hi = __atomic_load_n(&Found->Count.hi, __ATOMIC_RELAXED);
+   __atomic_thread_fence(__ATOMIC_ACQUIRE);
+   return __atomic_load_n(&Found->Key, __ATOMIC_RELAXED) == Key;
+  }
+
+  if (Entry == 0) return 0;
+ }
+
+ return 0;
+}
+
+
+/*FUNCTION:*/
+static void Memo_Insert(uint64_t Key, struct Count_Number Count)
+{
+ /*Takes the first empty slot of the run, when it is full the slot of the
+   board with the fewest beads, the cheapest to count again. A slot another
+   thread is writing or takes first is left alone, the count is then only
+   not stored*/
+
+ const uint64_t      Mask = ((uint64_t) 1 << COUNT_TABLE_BITS) - 1;
+ uint64_t            Slot = (Key * 0x9e3779b97f4a7c15ULL) >>
+                            (64 - COUNT_TABLE_BITS),
+                     Entry, Victim_Key = COUNT_BUSY;
+ struct Count_Entry *Found, *Victim = NULL;
+ int                 Probe;
+
+
+ for (Probe = 0; Probe < PROBE_LENGTH; Probe++)
+ {
+  Found = &Count_Table[(Slot + Probe) & Mask];
+  Entry = __atomic_load_n(&Found->Key, __ATOMIC_RELAXED);
+
+  if (Entry == Key) return;
+  if (Entry == COUNT_BUSY) continue;
+
+  if (Entry == 0 || Victim == NULL ||
+      POPCOUNT64(Entry) < POPCOUNT64(Victim_Key))
+  {
+   Victim     = Found;
+   Victim_Key = Entry;
+   if (Entry == 0) break;
+  }
+ }
+
+ if (Victim == NULL ||
+     !__atomic_compare_exchange_n(&Victim->Key, &Victim_Key, COUNT_BUSY, 0,
+                                  __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+   return;
+
+ /*BUSY is seen before the count changes, by a reader checking the key
+   again after its fence*/
+ __atomic_thread_fence(__ATOMIC_RELEASE);
+ __atomic_store_n(&Victim->Count.lo, Count.lo, __ATOMIC_RELAXED);
+ __atomic_store_n(&Victim->Count.hi, Count.hi, __ATOMIC_RELAXED);
+ __atomic_store_n(&Victim->Key, Key, __ATOMIC_RELEASE);
+}
+
+
+/*FUNCTION:*/
+static int Dead_Lookup(uint64_t Key)
+{
+ const uint64_t Mask = ((uint64_t) 1 << COUNT_DEAD_BITS) - 1;
+ uint64_t       Slot = (Key * 0x9e3779b97f4a7c15ULL) >> (64 - COUNT_DEAD_BITS),
+                Entry;
+ int            Probe;
+
+
+ for (Probe = 0; Probe < PROBE_LENGTH; Probe++)
+ {
+  Entry = __atomic_load_n(&Dead_Table[(Slot + Probe) & Mask], __ATOMIC_RELAXED);
+  if (Entry == Key) return 1;
+  if (Entry == 0)   return 0;
+ }
+
+ return 0;
+}
+
+
+/*FUNCTION:*/
+static void Dead_Insert(uint64_t Key)
+{
+ /*A key is 1 word, a compare & swap puts it in the first empty slot of the
+   run or in place of the board with the fewest beads when the run is full*/
+
+ const uint64_t Mask = ((uint64_t) 1 << COUNT_DEAD_BITS) - 1;
+ uint64_t       Slot = (Key * 0x9e3779b97f4a7c15ULL) >> (64 - COUNT_DEAD_BITS),
+                Entry, Victim_Key = 0;
+ uint64_t      *Victim = NULL;
+ int            Probe;
+
+
+ for (Probe = 0; Probe < PROBE_LENGTH; Probe++)
+ {
+  Entry = __atomic_load_n(&Dead_Table[(Slot + Probe) & Mask], __ATOMIC_RELAXED);
+
+  if (Entry == Key) return;
+
+  if (Entry == 0 || Victim == NULL ||
+      POPCOUNT64(Entry) < POPCOUNT64(Victim_Key))
+  {
+   Victim     = &Dead_Table[(Slot + Probe) & Mask];
+   Victim_Key = Entry;
+   if (Entry == 0) break;
+  }
+ }
+
+ __atomic_compare_exchange_n(Victim, &Victim_Key, Key, 0, __ATOMIC_RELAXED,
+                             __ATOMIC_RELAXED);
+}
+
+
+/*FUNCTION:*/
+static struct Count_Number Count_Add(struct Count_Number A,
+                                     struct Count_Number B)
+{
+ /*A + B, stops at 2^128 - 1*/
+
+ struct Count_Number Sum;
+ uint64_t            Carry;
+
+
+ Sum.lo = A.lo + B.lo;
+ Carry  = Sum.lo < A.lo;
+ Sum.hi = A.hi + B.hi + Carry;
+
+ if (Sum.hi < A.hi || (Sum.hi == A.hi && (B.hi | Carry) != 0))
+   return Count_Full;
+
+ return Sum;
+}
+
+
+/*FUNCTION:*/
+static struct Count_Number Count_Multiply(struct Count_Number A,
+                                          uint64_t Weight)
+{
+ /*A * Weight, stops at 2^128 - 1. Each word of A times Weight is a 128 bit
+   Part {lo, hi} made of the 4 products of their 32 bit halves*/
+
+ const uint64_t      Half = 0xffffffff;
+ struct Count_Number Part[2], Product;
+ uint64_t            Word, Low, Cross_1, Cross_2, Middle;
+ int                 Index;
+
+
+ for (Index = 0; Index < 2; Index++)
+ {
+  Word    = Index ? A.hi : A.lo;
+  Low     = (Word & Half) * (Weight & Half);
+  Cross_1 = (Word >> 32)  * (Weight & Half);
+  Cross_2 = (Word & Half) * (Weight >> 32);
+  Middle  = (Low >> 32) + (Cross_1 & Half) + (Cross_2 & Half);
+
+  Part[Index].lo = (Middle << 32) | (Low & Half);
+  Part[Index].hi = (Word >> 32) * (Weight >> 32) + (Cross_1 >> 32) +
+                   (Cross_2 >> 32) + (Middle >> 32);
+ }
+
+ Product.lo = Part[0].lo;
+ Product.hi = Part[0].hi + Part[1].lo;
+
+ if (Part[1].hi != 0 || Product.hi < Part[0].hi)
+   return Count_Full;
+
+ return Product;
+}
+
+
+/*FUNCTION:*/
+static int Task_Compare(const void *A, const void *B)
+{
+ uint64_t Left  = ((const struct Count_Task *) A)->Key,
+          Right = ((const struct Count_Task *) B)->Key;
+
+
+ return (Left > Right) - (Left < Right);
+}
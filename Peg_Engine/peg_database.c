@@ -0,0 +1,314 @@
+/*Date:    17Oct2026Sat 18:20
+//File:    peg_database.c
+//Desc:    Builds, maps & reads the endgame database of peg_database.h.
+           Layers are built in the packed 45 bit form where a jump is 3 bits,
+           a position of layer k is taken back 1 jump at a time (a bead on the
+           to hole, the over & from holes empty) to give the positions of
+           layer k + 1 that jump into it. Only 2 layers are in memory at once.
+*/
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#define _POSIX_C_SOURCE 200112L /*mmap, fstat*/
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "peg_database.h"
+#include "peg_rank.h"
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+/*1 jump of Jump_Table in the packed form*/
+struct Packed_Jump
+{
+ uint64_t From_Over, /*bits of the from & over holes*/
+          All;       /*from, over & to*/
+};
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+static void     Database_Init(void);
+static uint64_t Database_Layer_Bytes(int Pegs);
+
+
+/*----------------------------
+//Global Variable Declarations
+----------------------------*/
+/*By packed to hole*/
+static struct Packed_Jump Jumps_Into[BOARD_HOLES][JUMP_DIRECTIONS];
+static unsigned char      Jumps_Into_Count[BOARD_HOLES];
+static int                Database_Ready = 0;
+
+static const unsigned char        *Mapped      = NULL; /*the whole file*/
+static size_t                      Mapped_Size = 0;
+static const struct Database_Header *Mapped_Header;
+
+
+/*--------------------
+//Function Definitions (Implementation)
+--------------------*/
+
+
+/*FUNCTION:*/
+static void Database_Init(void)
+{
+ /*The rank tables & the jumps by packed to hole. Not thread safe, runs
+   from Database_Build & Database_Open*/
+
+ uint64_t From, Over, To;
+ int      Jump, Hole;
+
+
+ if (Database_Ready) return;
+
+ Rank_Init();
+
+ for (Jump = 0; Jump < JUMP_COUNT; Jump++)
+ {
+  From = Bitboard_Pack(Bitboard_Bit(Jump_Table[Jump].From));
+  Over = Bitboard_Pack(Bitboard_Bit(Jump_Table[Jump].Over));
+  To   = Bitboard_Pack(Bitboard_Bit(Jump_Table[Jump].To));
+  Hole = CTZ64(To);
+
+  Jumps_Into[Hole][Jumps_Into_Count[Hole]].From_Over = From | Over;
+  Jumps_Into[Hole][Jumps_Into_Count[Hole]++].All     = From | Over | To;
+ }
+
+ Database_Ready = 1;
+}
+
+
+/*FUNCTION:*/
+static uint64_t Database_Layer_Bytes(int Pegs)
+{
+ /*Whole 64 bit words so a layer can be scanned a word at a time*/
+
+ return (Rank_Count(Pegs) + 63) / 64 * 8;
+}
+
+
+/*FUNCTION:*/
+int Database_Build(const char *Path, int Max_Pegs)
+{
+ /*Writes the database of layers 1 to Max_Pegs to Path. Returns 0 when
+   memory runs out or the file cannot be written. Needs the memory of
+   layers Max_Pegs - 1 & Max_Pegs together*/
+
+ struct Database_Header    Header;
+ const struct Packed_Jump *Jump;
+ uint64_t                 *Layer, *Next, Word, Packed, Pegs_Left, Before,
+                           Offset;
+ int                       Pegs, Hole, Index, Written = 1;
+ FILE                     *fp;
+ size_t                    Words, Bit;
+
+
+ if (Max_Pegs < 1 || Max_Pegs > BOARD_HOLES - 1)
+   return 0;
+
+ Database_Init();
+
+ memset(&Header, 0, sizeof(Header));
+ memcpy(Header.Magic, "PEGD", 4);
+ Header.Version  = DATABASE_VERSION;
+ Header.Max_Pegs = Max_Pegs;
+ Header.Geometry = PEG_GEOMETRY;
+
+ Offset = (sizeof(Header) + DATABASE_PAGE - 1) / DATABASE_PAGE * DATABASE_PAGE;
+ for (Pegs = 1; Pegs <= Max_Pegs; Pegs++)
+ {
+  Header.Offset[Pegs] = Offset;
+  Offset += (Database_Layer_Bytes(Pegs) + DATABASE_PAGE - 1) / DATABASE_PAGE *
+            DATABASE_PAGE;
+ }
+
+ fp = fopen(Path, "wb");
+ if (fp == NULL) return 0;
+
+ /*Layer 1 is the finish, 1 bead on the centre*/
+ Layer = calloc(Database_Layer_Bytes(1), 1);
+ if (Layer == NULL)
+ {
+  fclose(fp);
+  return 0;
+ }
+
+ Packed = Bitboard_Pack(Bitboard_Bit(BOARD_CENTRE));
+ Bit    = Rank_Packed(Packed);
+ Layer[Bit / 64] |= (uint64_t) 1 << (Bit % 64);
+
+ for (Pegs = 1; Pegs <= Max_Pegs && Written; Pegs++)
+ {
+  Words = Database_Layer_Bytes(Pegs) / 8;
+
+  for (Bit = 0; Bit < Words; Bit++)
+    Header.Winnable[Pegs] += POPCOUNT64(Layer[Bit]);
+
+  Written = fseek(fp, (long) Header.Offset[Pegs], SEEK_SET) == 0 &&
+            fwrite(Layer, 8, Words, fp) == Words;
+
+  if (Pegs == Max_Pegs || !Written)
+    break;
+
+  Next = calloc(Database_Layer_Bytes(Pegs + 1), 1);
+  if (Next == NULL)
+  {
+   Written = 0;
+   break;
+  }
+
+  /*Every winnable board taken back by every jump that lands on 1 of its
+    beads with the from & over holes empty*/
+  for (Index = 0; (size_t) Index < Words; Index++)
+  {
+   for (Word = Layer[Index]; Word; Word &= Word - 1)
+   {
+    Packed = Unrank_Packed(Pegs, (uint64_t) Index * 64 + CTZ64(Word));
+
+    for (Pegs_Left = Packed; Pegs_Left; Pegs_Left &= Pegs_Left - 1)
+    {
+     Hole = CTZ64(Pegs_Left);
+
+     for (Jump = Jumps_Into[Hole];
+          Jump < Jumps_Into[Hole] + Jumps_Into_Count[Hole]; Jump++)
+        if (!(Packed & Jump->From_Over))
+        {
+         Before = Rank_Packed(Packed ^ Jump->All);
+         Next[Before / 64] |= (uint64_t) 1 << (Before % 64);
+        }
+    }
+   }
+  }
+
+  free(Layer);
+  Layer = Next;
+ }
+
+ free(Layer);
+
+ /*The last layer is padded to a whole page so the file maps cleanly*/
+ if (Written)
+   Written = fseek(fp, (long) Offset - 1, SEEK_SET) == 0 &&
+             fputc(0, fp) != EOF &&
+             fseek(fp, 0, SEEK_SET) == 0 &&
+             fwrite(&Header, sizeof(Header), 1, fp) == 1;
+
+ if (fclose(fp) != 0) Written = 0;
+ return Written;
+}
+
+
+/*FUNCTION:*/
+int Database_Open(const char *Path)
+{
+ /*Maps the database at Path read only, replacing any open one. Returns 0
+   when the file is missing or not a whole database of this version*/
+
+ const struct Database_Header *Header;
+ struct stat                   Status;
+ void                         *File;
+ int                           Fd, Pegs;
+
+
+ Database_Init();
+ Database_Close();
+
+ Fd = open(Path, O_RDONLY);
+ if (Fd < 0) return 0;
+
+ if (fstat(Fd, &Status) < 0 ||
+     (size_t) Status.st_size < sizeof(struct Database_Header))
+ {
+  close(Fd);
+  return 0;
+ }
+
+ File = mmap(NULL, Status.st_size, PROT_READ, MAP_SHARED, Fd, 0);
+ close(Fd);
+ if (File == MAP_FAILED) return 0;
+
+ Header = File;
+ if (memcmp(Header->Magic, "PEGD", 4) != 0 ||
+     Header->Version != DATABASE_VERSION || Header->Geometry != PEG_GEOMETRY ||
+     Header->Max_Pegs < 1 || Header->Max_Pegs > BOARD_HOLES - 1)
+ {
+  munmap(File, Status.st_size);
+  return 0;
+ }
+
+ for (Pegs = 1; Pegs <= (int) Header->Max_Pegs; Pegs++)
+    if (Header->Offset[Pegs] % DATABASE_PAGE != 0 ||
+        Header->Offset[Pegs] + Database_Layer_Bytes(Pegs) >
+        (uint64_t) Status.st_size)
+    {
+     munmap(File, Status.st_size);
+     return 0;
+    }
+
+ Mapped        = File;
+ Mapped_Size   = Status.st_size;
+ Mapped_Header = Header;
+ return 1;
+}
+
+
+/*FUNCTION:*/
+int Database_Lookup(struct Bitboard Pegs)
+{
+ /*1 when Pegs can still finish on the centre, 0 when it cannot & -1 when no
+   database is open or it has no layer for that many beads. Thread safe*/
+
+ const uint64_t *Layer;
+ uint64_t        Rank;
+ int             Beads = Bitboard_Count(Pegs);
+
+
+ if (Mapped == NULL || Beads < 1 || Beads > (int) Mapped_Header->Max_Pegs)
+   return -1;
+
+ Rank  = Rank_Pegs(Pegs);
+ Layer = (const uint64_t *) (Mapped + Mapped_Header->Offset[Beads]);
+ return (int) ((Layer[Rank / 64] >> (Rank % 64)) & 1);
+}
+
+
+/*FUNCTION:*/
+int Database_Max_Pegs(void)
+{
+ /*Most beads the open database answers for, 0 with none open*/
+
+ return Mapped ? (int) Mapped_Header->Max_Pegs : 0;
+}
+
+
+/*FUNCTION:*/
+uint64_t Database_Winnable(int Pegs)
+{
+ /*Winnable positions of Pegs beads in the open database*/
+
+ if (Mapped == NULL || Pegs < 1 || Pegs > (int) Mapped_Header->Max_Pegs)
+   return 0;
+
+ return Mapped_Header->Winnable[Pegs];
+}
+
+
+/*FUNCTION:*/
+void Database_Close(void)
+{
+ if (Mapped != NULL)
+   munmap((void *) Mapped, Mapped_Size);
+
+ Mapped      = NULL;
+ Mapped_Size = 0;
+}
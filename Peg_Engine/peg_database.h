@@ -0,0 +1,68 @@
+/*Date:    17Oct2026Sat 18:20
+//File:    peg_database.h
+//Desc:    Retrograde endgame database: for every position of up to Max_Pegs
+           beads 1 bit telling whether it can still finish with 1 bead on
+           board[4][4] (BOARD_CENTRE, see peg_geometry.h). Built backwards
+           from that finish, layer by layer: the winnable positions of k + 1
+           beads are exactly those with a jump into a winnable position of k
+           beads.
+
+           Each layer is a dense bitset indexed by the rank of the board among
+           the C(45, k) boards of k beads (see peg_rank.h), so an answer is 1
+           bit in 1 page of the mapped file & no search at all. Dense layers
+           grow fast, about C(45, k) / 8 bytes:
+
+            beads  1-8   35 MB
+                   9    111 MB
+                  10    399 MB
+                  11   1.3 GB
+
+           so the database covers the endgame & the solver searches down to
+           it. The file is mapped read only & shared by every process using
+           it; its header is in host byte order, build it on the machine that
+           reads it.
+
+           File layout: struct Database_Header, then layer k from byte
+           Offset[k] (a multiple of 4096) for k = 1 to Max_Pegs.
+*/
+
+
+#ifndef PEG_DATABASE_H
+#define PEG_DATABASE_H
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include "peg_engine.h"
+
+#define DATABASE_VERSION 1
+#define DATABASE_PEGS    9  /*default Max_Pegs of a build*/
+#define DATABASE_PAGE    4096
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+struct Database_Header
+{
+ char     Magic[4];                /*"PEGD"*/
+ uint32_t Version,
+          Max_Pegs,
+          Geometry;                /*PEG_GEOMETRY, 0 for the cross*/
+ uint64_t Offset[BOARD_HOLES + 1]; /*byte offset of layer k, 0 for none*/
+ uint64_t Winnable[BOARD_HOLES + 1]; /*bits set in layer k*/
+};
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+int  Database_Build(const char *Path, int Max_Pegs);
+int  Database_Open(const char *Path);
+int  Database_Lookup(struct Bitboard Pegs);
+int  Database_Max_Pegs(void);
+uint64_t Database_Winnable(int Pegs);
+void Database_Close(void);
+
+#endif
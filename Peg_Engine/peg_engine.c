@@ -0,0 +1,1025 @@
+/*Date:    17Oct2026Sat 09:12
+//File:    peg_engine.c
+//Desc:    Bitboard rules engine shared by the Peg Solitaire front ends, see
+           peg_engine.h for the bit layout.
+
+           To compile as part of a front end add the Peg_Engine sources to its
+           gcc command, see the header of peg_solitaire.c. Adding -mavx2
+           switches Bitboard_Mobility_Batch from SSE2 to AVX2 on x86-64,
+           -mbmi2 makes Bitboard_Pack & Bitboard_Unpack 1 pext / pdep per word,
+           -DPEG_GEOMETRY=GEOMETRY_ENGLISH & so on builds it for another board
+           (see peg_geometry.h)
+*/
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include "peg_engine.h"
+
+/*Batch mobility kernel, picked from the instruction sets the compiler may
+  use (-mavx2, x86-64 always has SSE2). -DPEG_ENGINE_SCALAR forces plain C,
+  which is also what every other cpu gets*/
+#if defined(__AVX2__) && !defined(PEG_ENGINE_SCALAR)
+#include <immintrin.h>
+#define PEG_ENGINE_AVX2
+#elif defined(__SSE2__) && !defined(PEG_ENGINE_SCALAR)
+#include <emmintrin.h>
+#define PEG_ENGINE_SSE2
+#endif
+
+/*Packing with the BMI2 bit gather / scatter instructions (-mbmi2)*/
+#if defined(__BMI2__) && !defined(PEG_ENGINE_SCALAR)
+#include <immintrin.h>
+#define PEG_ENGINE_BMI2
+#endif
+
+/*Whole board shifts inside each 128 bit lane {lo, hi}, 0 < n < 64. The bits
+  crossing from lo to hi are moved over by a whole byte shift first*/
+#ifdef PEG_ENGINE_AVX2
+#define SIMD_SHIFT_UP(x, n)   _mm256_or_si256(_mm256_slli_epi64(x, n), \
+                         _mm256_srli_epi64(_mm256_bslli_epi128(x, 8), 64 - (n)))
+#define SIMD_SHIFT_DOWN(x, n) _mm256_or_si256(_mm256_srli_epi64(x, n), \
+                         _mm256_slli_epi64(_mm256_bsrli_epi128(x, 8), 64 - (n)))
+#endif
+
+#ifdef PEG_ENGINE_SSE2
+#define SIMD_SHIFT_UP(x, n)   _mm_or_si128(_mm_slli_epi64(x, n), \
+                               _mm_srli_epi64(_mm_slli_si128(x, 8), 64 - (n)))
+#define SIMD_SHIFT_DOWN(x, n) _mm_or_si128(_mm_srli_epi64(x, n), \
+                               _mm_slli_epi64(_mm_srli_si128(x, 8), 64 - (n)))
+#endif
+
+
+/*----------------------------
+//Global Variable Declarations
+----------------------------*/
+/*Distance between the jumping bead & the bead jumped over, indexed by
+  enum Jump_Direction*/
+#if JUMP_DIRECTIONS == 6
+const int Jump_Offset[JUMP_DIRECTIONS] = {-BOARD_STRIDE, BOARD_STRIDE, -1, 1,
+                                          -BOARD_STRIDE - 1, BOARD_STRIDE + 1};
+#else
+const int Jump_Offset[JUMP_DIRECTIONS] = {-BOARD_STRIDE, BOARD_STRIDE, -1, 1};
+#endif
+
+/*Zobrist keys: 1 fixed random 64 bit word per hole of the grid (0 on
+  padding), a position hashes to the XOR of the words of its beads. The words
+  never change between runs so hashes may be stored in files, every board of
+  peg_geometry.h hashes with the words of its holes*/
+const uint64_t Zobrist_Keys[BOARD_BITS] =
+{
+ /*row 0*/
+ 0x9ac6788a99f24834ULL, 0x0d36501da3648a0fULL, 0x751722d3d34775b6ULL,
+ 0x7ec8ecdc5f48e986ULL, 0x3f29519f362e789cULL, 0xbda001c90aa4fccdULL,
+ 0xc4b5727bd56ff13aULL, 0x0cf8810e9ef6cb00ULL, 0x28e22d3fad748e82ULL,
+ 0,
+ /*row 1*/
+ 0xf2ff7b6236b40d50ULL, 0xc60536fb220c6b23ULL, 0x39149de89500b772ULL,
+ 0xe7474b8672bde67bULL, 0x486643922e41b30fULL, 0xde589e2fd198360bULL,
+ 0x357580d1e2a5fa49ULL, 0x4bb557e8860a96d0ULL, 0xc5f5cfa76bd11404ULL,
+ 0,
+ /*row 2*/
+ 0x15dd38faeb55c3f6ULL, 0xcc6edfd43bca97d2ULL, 0xc52a9f850b52923cULL,
+ 0x444633f586c40b0fULL, 0x68910b0f6177badaULL, 0x220bcefce60b8ba2ULL,
+ 0x927fbcaa34cabe67ULL, 0x1ff6c949fbcba3d0ULL, 0x1375079b37c37aa4ULL,
+ 0,
+ /*row 3*/
+ 0xb88789096c8dcc01ULL, 0x9f2409307f7db5c2ULL, 0x72e0d1360ceb9fa6ULL,
+ 0x6398d72de056794cULL, 0x1c45fa50ed9a5ea8ULL, 0x1449dd352ce29104ULL,
+ 0xf2e26cd93ee7610aULL, 0xfd1f8efdea0f060eULL, 0x952c006cbfd53ebaULL,
+ 0,
+ /*row 4*/
+ 0x1dbbd2b1475c38ecULL, 0x5ccd1c2947b9da3bULL, 0xb71d1e10443a7f48ULL,
+ 0x41eb6bda623f6af4ULL, 0x98ac63c4bbbe01d2ULL, 0xcff401e0d17e4829ULL,
+ 0x5074e420d52a27c5ULL, 0x758140e4bd925437ULL, 0x3eb66471a4a1ac15ULL,
+ 0,
+ /*row 5*/
+ 0x65deb7789ad6043eULL, 0xdef6e254fb9b1fd3ULL, 0x94599cede9d7a70bULL,
+ 0xdcce09a9b246f6beULL, 0x04f0fcf2f90c60a0ULL, 0xc54ddebfcec40f9aULL,
+ 0x9a2f1cd98670ba0bULL, 0xe3fa97a7c4996d7cULL, 0xec2431fb135decfeULL,
+ 0,
+ /*row 6*/
+ 0x097f0a5a39077f7aULL, 0x25ca80341b67b60bULL, 0x9059cb6285cf5047ULL,
+ 0x2308405f4c010f74ULL, 0x5b71bc601c374dffULL, 0x870dbaf612fe0d23ULL,
+ 0x60ab295a35514be2ULL, 0x1ccda469dda5683cULL, 0x7d8d1936795bf1c1ULL,
+ 0,
+ /*row 7*/
+ 0x51700e0ed5da8eb8ULL, 0x52d8ccdfc6dbe195ULL, 0xff4ae0c3c7efbe86ULL,
+ 0xbfeaa95f80c5dd18ULL, 0x07ac6797291a0e25ULL, 0x300842523dd4d43dULL,
+ 0x14a0617e93729166ULL, 0xbf85d68997d703a0ULL, 0x7a92382aefd1bd3aULL,
+ 0,
+ /*row 8*/
+ 0xde28265df9f9788aULL, 0x96825eef5cf9e5d5ULL, 0x2b7bac30ab094c26ULL,
+ 0x2a369b5dc9d0ae35ULL, 0x04b6ccd1cfefe064ULL, 0xd5ad5e86c2bdd9acULL,
+ 0x1f41eccfe6ad0e9eULL, 0x031a6265ad928d94ULL, 0xf9bb3d23075c0ab9ULL,
+ 0
+};
+
+/*The board of the build, see peg_geometry.h. Jump_Table holds every legal
+  (from, over, to) triple as bit indices, sorted by from hole & then by enum
+  Jump_Direction, written out from Valid_Holes & Jump_Offset: a jump is legal
+  on a board when from & over hold beads & to is empty. The jumps starting on
+  hole n are Jump_Table[Jump_First[n]] up to but not including
+  Jump_Table[Jump_First[n + 1]], 1 row of the grid per line. Row_First_Hole &
+  Row_Width are the bit index of the first valid hole of each row & the
+  number of holes. Board_Picture is what the front ends draw, hole (r, c) at
+  line 2r + 2, column 4c + 4. Symmetry_Kind lists the cases of Symmetry_Init
+  that keep the finish in place*/
+#if PEG_GEOMETRY == GEOMETRY_CROSS
+/*Rows 0 to 2 & 6 to 8 hold columns 3 to 5, rows 3 to 5 hold columns 0 to 8*/
+const struct Bitboard Valid_Holes = {0x87fdff7fc380e038ULL, 0x380e03ULL};
+
+/*Same as Valid_Holes without bit 44 (board[4][4])*/
+const struct Bitboard Start_Pegs  = {0x87fdef7fc380e038ULL, 0x380e03ULL};
+
+const struct Jump Jump_Table[JUMP_COUNT] =
+{
+ { 3, 13, 23}, { 3,  4,  5},
+ { 4, 14, 24},
+ { 5, 15, 25}, { 5,  4,  3},
+ {13, 23, 33}, {13, 14, 15},
+ {14, 24, 34},
+ {15, 25, 35}, {15, 14, 13},
+ {23, 13,  3}, {23, 33, 43}, {23, 24, 25},
+ {24, 14,  4}, {24, 34, 44},
+ {25, 15,  5}, {25, 35, 45}, {25, 24, 23},
+ {30, 40, 50}, {30, 31, 32},
+ {31, 41, 51}, {31, 32, 33},
+ {32, 42, 52}, {32, 31, 30}, {32, 33, 34},
+ {33, 23, 13}, {33, 43, 53}, {33, 32, 31}, {33, 34, 35},
+ {34, 24, 14}, {34, 44, 54}, {34, 33, 32}, {34, 35, 36},
+ {35, 25, 15}, {35, 45, 55}, {35, 34, 33}, {35, 36, 37},
+ {36, 46, 56}, {36, 35, 34}, {36, 37, 38},
+ {37, 47, 57}, {37, 36, 35},
+ {38, 48, 58}, {38, 37, 36},
+ {40, 41, 42},
+ {41, 42, 43},
+ {42, 41, 40}, {42, 43, 44},
+ {43, 33, 23}, {43, 53, 63}, {43, 42, 41}, {43, 44, 45},
+ {44, 34, 24}, {44, 54, 64}, {44, 43, 42}, {44, 45, 46},
+ {45, 35, 25}, {45, 55, 65}, {45, 44, 43}, {45, 46, 47},
+ {46, 45, 44}, {46, 47, 48},
+ {47, 46, 45},
+ {48, 47, 46},
+ {50, 40, 30}, {50, 51, 52},
+ {51, 41, 31}, {51, 52, 53},
+ {52, 42, 32}, {52, 51, 50}, {52, 53, 54},
+ {53, 43, 33}, {53, 63, 73}, {53, 52, 51}, {53, 54, 55},
+ {54, 44, 34}, {54, 64, 74}, {54, 53, 52}, {54, 55, 56},
+ {55, 45, 35}, {55, 65, 75}, {55, 54, 53}, {55, 56, 57},
+ {56, 46, 36}, {56, 55, 54}, {56, 57, 58},
+ {57, 47, 37}, {57, 56, 55},
+ {58, 48, 38}, {58, 57, 56},
+ {63, 53, 43}, {63, 73, 83}, {63, 64, 65},
+ {64, 54, 44}, {64, 74, 84},
+ {65, 55, 45}, {65, 75, 85}, {65, 64, 63},
+ {73, 63, 53}, {73, 74, 75},
+ {74, 64, 54},
+ {75, 65, 55}, {75, 74, 73},
+ {83, 73, 63}, {83, 84, 85},
+ {84, 74, 64},
+ {85, 75, 65}, {85, 84, 83}
+};
+
+const unsigned char Jump_First[BOARD_BITS + 1] =
+{
+   0,   0,   0,   0,   2,   3,   5,   5,   5,   5,
+   5,   5,   5,   5,   7,   8,  10,  10,  10,  10,
+  10,  10,  10,  10,  13,  15,  18,  18,  18,  18,
+  18,  20,  22,  25,  29,  33,  37,  40,  42,  44,
+  44,  45,  46,  48,  52,  56,  60,  62,  63,  64,
+  64,  66,  68,  71,  75,  79,  83,  86,  88,  90,
+  90,  90,  90,  90,  93,  95,  98,  98,  98,  98,
+  98,  98,  98,  98, 100, 101, 103, 103, 103, 103,
+ 103, 103, 103, 103, 105, 106, 108, 108, 108, 108,
+ 108
+};
+
+#ifndef PEG_ENGINE_BMI2
+static const unsigned char Row_First_Hole[BOARD_SIZE] =
+                           {3, 13, 23, 30, 40, 50, 63, 73, 83};
+static const unsigned char Row_Width[BOARD_SIZE] = {3, 3, 3, 9, 9, 9, 3, 3, 3};
+#endif
+
+const char * const Board_Picture[BOARD_PICTURE_LINES] =
+{
+ "    0   1   2   3   4   5   6   7   8",
+ "              +---+---+---+",
+ "0             |   |   |   |             0",
+ "              +---+---+---+",
+ "1             |   |   |   |             1",
+ "              +---+---+---+",
+ "2             |   |   |   |             2",
+ "  +---+---+---+---+---+---+---+---+---+",
+ "3 |   |   |   |   |   |   |   |   |   | 3",
+ "  +---+---+---+---+---+---+---+---+---+",
+ "4 |   |   |   |   |   |   |   |   |   | 4",
+ "  +---+---+---+---+---+---+---+---+---+",
+ "5 |   |   |   |   |   |   |   |   |   | 5",
+ "  +---+---+---+---+---+---+---+---+---+",
+ "6             |   |   |   |             6",
+ "              +---+---+---+",
+ "7             |   |   |   |             7",
+ "              +---+---+---+",
+ "8             |   |   |   |             8",
+ "              +---+---+---+",
+ "    0   1   2   3   4   5   6   7   8"
+};
+
+static const unsigned char Symmetry_Kind[BOARD_SYMMETRIES] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+#elif PEG_GEOMETRY == GEOMETRY_ENGLISH
+/*Rows 1, 2, 6 & 7 hold columns 3 to 5, rows 3 to 5 hold columns 1 to 7*/
+const struct Bitboard Valid_Holes = {0x83f8fe3f8380e000ULL, 0xe03ULL};
+
+/*Same as Valid_Holes without bit 44 (board[4][4])*/
+const struct Bitboard Start_Pegs  = {0x83f8ee3f8380e000ULL, 0xe03ULL};
+
+const struct Jump Jump_Table[JUMP_COUNT] =
+{
+ {13, 23, 33}, {13, 14, 15},
+ {14, 24, 34},
+ {15, 25, 35}, {15, 14, 13},
+ {23, 33, 43}, {23, 24, 25},
+ {24, 34, 44},
+ {25, 35, 45}, {25, 24, 23},
+ {31, 41, 51}, {31, 32, 33},
+ {32, 42, 52}, {32, 33, 34},
+ {33, 23, 13}, {33, 43, 53}, {33, 32, 31}, {33, 34, 35},
+ {34, 24, 14}, {34, 44, 54}, {34, 33, 32}, {34, 35, 36},
+ {35, 25, 15}, {35, 45, 55}, {35, 34, 33}, {35, 36, 37},
+ {36, 46, 56}, {36, 35, 34},
+ {37, 47, 57}, {37, 36, 35},
+ {41, 42, 43},
+ {42, 43, 44},
+ {43, 33, 23}, {43, 53, 63}, {43, 42, 41}, {43, 44, 45},
+ {44, 34, 24}, {44, 54, 64}, {44, 43, 42}, {44, 45, 46},
+ {45, 35, 25}, {45, 55, 65}, {45, 44, 43}, {45, 46, 47},
+ {46, 45, 44},
+ {47, 46, 45},
+ {51, 41, 31}, {51, 52, 53},
+ {52, 42, 32}, {52, 53, 54},
+ {53, 43, 33}, {53, 63, 73}, {53, 52, 51}, {53, 54, 55},
+ {54, 44, 34}, {54, 64, 74}, {54, 53, 52}, {54, 55, 56},
+ {55, 45, 35}, {55, 65, 75}, {55, 54, 53}, {55, 56, 57},
+ {56, 46, 36}, {56, 55, 54},
+ {57, 47, 37}, {57, 56, 55},
+ {63, 53, 43}, {63, 64, 65},
+ {64, 54, 44},
+ {65, 55, 45}, {65, 64, 63},
+ {73, 63, 53}, {73, 74, 75},
+ {74, 64, 54},
+ {75, 65, 55}, {75, 74, 73}
+};
+
+const unsigned char Jump_First[BOARD_BITS + 1] =
+{
+   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+   0,   0,   0,   0,   2,   3,   5,   5,   5,   5,
+   5,   5,   5,   5,   7,   8,  10,  10,  10,  10,
+  10,  10,  12,  14,  18,  22,  26,  28,  30,  30,
+  30,  30,  31,  32,  36,  40,  44,  45,  46,  46,
+  46,  46,  48,  50,  54,  58,  62,  64,  66,  66,
+  66,  66,  66,  66,  68,  69,  71,  71,  71,  71,
+  71,  71,  71,  71,  73,  74,  76,  76,  76,  76,
+  76,  76,  76,  76,  76,  76,  76,  76,  76,  76,
+  76
+};
+
+#ifndef PEG_ENGINE_BMI2
+static const unsigned char Row_First_Hole[BOARD_SIZE] =
+                           {0, 13, 23, 31, 41, 51, 63, 73, 80};
+static const unsigned char Row_Width[BOARD_SIZE] = {0, 3, 3, 7, 7, 7, 3, 3, 0};
+#endif
+
+const char * const Board_Picture[BOARD_PICTURE_LINES] =
+{
+ "    0   1   2   3   4   5   6   7   8",
+ "",
+ "0                                       0",
+ "              +---+---+---+",
+ "1             |   |   |   |             1",
+ "              +---+---+---+",
+ "2             |   |   |   |             2",
+ "      +---+---+---+---+---+---+---+",
+ "3     |   |   |   |   |   |   |   |     3",
+ "      +---+---+---+---+---+---+---+",
+ "4     |   |   |   |   |   |   |   |     4",
+ "      +---+---+---+---+---+---+---+",
+ "5     |   |   |   |   |   |   |   |     5",
+ "      +---+---+---+---+---+---+---+",
+ "6             |   |   |   |             6",
+ "              +---+---+---+",
+ "7             |   |   |   |             7",
+ "              +---+---+---+",
+ "8                                       8",
+ "",
+ "    0   1   2   3   4   5   6   7   8"
+};
+
+static const unsigned char Symmetry_Kind[BOARD_SYMMETRIES] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+#elif PEG_GEOMETRY == GEOMETRY_EUROPEAN
+/*The English holes & board[2][2], [2][6], [6][2] & [6][6]*/
+const struct Bitboard Valid_Holes = {0xc3f8fe3f87c0e000ULL, 0xe07ULL};
+
+/*Same as Valid_Holes without bit 24 (board[2][4])*/
+const struct Bitboard Start_Pegs  = {0xc3f8fe3f86c0e000ULL, 0xe07ULL};
+
+const struct Jump Jump_Table[JUMP_COUNT] =
+{
+ {13, 23, 33}, {13, 14, 15},
+ {14, 24, 34},
+ {15, 25, 35}, {15, 14, 13},
+ {22, 32, 42}, {22, 23, 24},
+ {23, 33, 43}, {23, 24, 25},
+ {24, 34, 44}, {24, 23, 22}, {24, 25, 26},
+ {25, 35, 45}, {25, 24, 23},
+ {26, 36, 46}, {26, 25, 24},
+ {31, 41, 51}, {31, 32, 33},
+ {32, 42, 52}, {32, 33, 34},
+ {33, 23, 13}, {33, 43, 53}, {33, 32, 31}, {33, 34, 35},
+ {34, 24, 14}, {34, 44, 54}, {34, 33, 32}, {34, 35, 36},
+ {35, 25, 15}, {35, 45, 55}, {35, 34, 33}, {35, 36, 37},
+ {36, 46, 56}, {36, 35, 34},
+ {37, 47, 57}, {37, 36, 35},
+ {41, 42, 43},
+ {42, 32, 22}, {42, 52, 62}, {42, 43, 44},
+ {43, 33, 23}, {43, 53, 63}, {43, 42, 41}, {43, 44, 45},
+ {44, 34, 24}, {44, 54, 64}, {44, 43, 42}, {44, 45, 46},
+ {45, 35, 25}, {45, 55, 65}, {45, 44, 43}, {45, 46, 47},
+ {46, 36, 26}, {46, 56, 66}, {46, 45, 44},
+ {47, 46, 45},
+ {51, 41, 31}, {51, 52, 53},
+ {52, 42, 32}, {52, 53, 54},
+ {53, 43, 33}, {53, 63, 73}, {53, 52, 51}, {53, 54, 55},
+ {54, 44, 34}, {54, 64, 74}, {54, 53, 52}, {54, 55, 56},
+ {55, 45, 35}, {55, 65, 75}, {55, 54, 53}, {55, 56, 57},
+ {56, 46, 36}, {56, 55, 54},
+ {57, 47, 37}, {57, 56, 55},
+ {62, 52, 42}, {62, 63, 64},
+ {63, 53, 43}, {63, 64, 65},
+ {64, 54, 44}, {64, 63, 62}, {64, 65, 66},
+ {65, 55, 45}, {65, 64, 63},
+ {66, 56, 46}, {66, 65, 64},
+ {73, 63, 53}, {73, 74, 75},
+ {74, 64, 54},
+ {75, 65, 55}, {75, 74, 73}
+};
+
+const unsigned char Jump_First[BOARD_BITS + 1] =
+{
+   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+   0,   0,   0,   0,   2,   3,   5,   5,   5,   5,
+   5,   5,   5,   7,   9,  12,  14,  16,  16,  16,
+  16,  16,  18,  20,  24,  28,  32,  34,  36,  36,
+  36,  36,  37,  40,  44,  48,  52,  55,  56,  56,
+  56,  56,  58,  60,  64,  68,  72,  74,  76,  76,
+  76,  76,  76,  78,  80,  83,  85,  87,  87,  87,
+  87,  87,  87,  87,  89,  90,  92,  92,  92,  92,
+  92,  92,  92,  92,  92,  92,  92,  92,  92,  92,
+  92
+};
+
+#ifndef PEG_ENGINE_BMI2
+static const unsigned char Row_First_Hole[BOARD_SIZE] =
+                           {0, 13, 22, 31, 41, 51, 62, 73, 80};
+static const unsigned char Row_Width[BOARD_SIZE] = {0, 3, 5, 7, 7, 7, 5, 3, 0};
+#endif
+
+const char * const Board_Picture[BOARD_PICTURE_LINES] =
+{
+ "    0   1   2   3   4   5   6   7   8",
+ "",
+ "0                                       0",
+ "              +---+---+---+",
+ "1             |   |   |   |             1",
+ "          +---+---+---+---+---+",
+ "2         |   |   |   |   |   |         2",
+ "      +---+---+---+---+---+---+---+",
+ "3     |   |   |   |   |   |   |   |     3",
+ "      +---+---+---+---+---+---+---+",
+ "4     |   |   |   |   |   |   |   |     4",
+ "      +---+---+---+---+---+---+---+",
+ "5     |   |   |   |   |   |   |   |     5",
+ "      +---+---+---+---+---+---+---+",
+ "6         |   |   |   |   |   |         6",
+ "          +---+---+---+---+---+",
+ "7             |   |   |   |             7",
+ "              +---+---+---+",
+ "8                                       8",
+ "",
+ "    0   1   2   3   4   5   6   7   8"
+};
+
+static const unsigned char Symmetry_Kind[BOARD_SYMMETRIES] = {0, 4};
+
+#elif PEG_GEOMETRY == GEOMETRY_TRIANGLE
+/*Row r of 2 to 6 holds columns 2 to r*/
+const struct Bitboard Valid_Holes = {0xc0f01c0300400000ULL, 0x7ULL};
+
+/*Same as Valid_Holes without bit 22 (board[2][2])*/
+const struct Bitboard Start_Pegs  = {0xc0f01c0300000000ULL, 0x7ULL};
+
+const struct Jump Jump_Table[JUMP_COUNT] =
+{
+ {22, 32, 42}, {22, 33, 44},
+ {32, 42, 52}, {32, 43, 54},
+ {33, 43, 53}, {33, 44, 55},
+ {42, 32, 22}, {42, 52, 62}, {42, 43, 44}, {42, 53, 64},
+ {43, 53, 63}, {43, 54, 65},
+ {44, 54, 64}, {44, 43, 42}, {44, 33, 22}, {44, 55, 66},
+ {52, 42, 32}, {52, 53, 54},
+ {53, 43, 33}, {53, 54, 55},
+ {54, 53, 52}, {54, 43, 32},
+ {55, 54, 53}, {55, 44, 33},
+ {62, 52, 42}, {62, 63, 64},
+ {63, 53, 43}, {63, 64, 65},
+ {64, 54, 44}, {64, 63, 62}, {64, 65, 66}, {64, 53, 42},
+ {65, 64, 63}, {65, 54, 43},
+ {66, 65, 64}, {66, 55, 44}
+};
+
+const unsigned char Jump_First[BOARD_BITS + 1] =
+{
+   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+   0,   0,   0,   2,   2,   2,   2,   2,   2,   2,
+   2,   2,   2,   4,   6,   6,   6,   6,   6,   6,
+   6,   6,   6,  10,  12,  16,  16,  16,  16,  16,
+  16,  16,  16,  18,  20,  22,  24,  24,  24,  24,
+  24,  24,  24,  26,  28,  32,  34,  36,  36,  36,
+  36,  36,  36,  36,  36,  36,  36,  36,  36,  36,
+  36,  36,  36,  36,  36,  36,  36,  36,  36,  36,
+  36
+};
+
+#ifndef PEG_ENGINE_BMI2
+static const unsigned char Row_First_Hole[BOARD_SIZE] =
+                           {0, 10, 22, 32, 42, 52, 62, 70, 80};
+static const unsigned char Row_Width[BOARD_SIZE] = {0, 0, 1, 2, 3, 4, 5, 0, 0};
+#endif
+
+const char * const Board_Picture[BOARD_PICTURE_LINES] =
+{
+ "    0   1   2   3   4   5   6   7   8",
+ "",
+ "0                                       0",
+ "",
+ "1                                       1",
+ "          +---+",
+ "2         |   |                         2",
+ "          +---+---+",
+ "3         |   |   |                     3",
+ "          +---+---+---+",
+ "4         |   |   |   |                 4",
+ "          +---+---+---+---+",
+ "5         |   |   |   |   |             5",
+ "          +---+---+---+---+---+",
+ "6         |   |   |   |   |   |         6",
+ "          +---+---+---+---+---+",
+ "7                                       7",
+ "",
+ "8                                       8",
+ "",
+ "    0   1   2   3   4   5   6   7   8"
+};
+
+static const unsigned char Symmetry_Kind[BOARD_SYMMETRIES] = {0};
+#endif
+
+/*Symmetry_Table[s][b][v] is the image under symmetry s of byte b of a packed
+  board holding value v, OR-ing the 6 byte images gives the whole image*/
+static uint64_t Symmetry_Table[BOARD_SYMMETRIES][6][256];
+static int      Symmetry_Ready = 0;
+
+
+/*--------------------
+//Function Definitions (Implementation)
+--------------------*/
+
+
+/*FUNCTION:*/
+void Bitboard_Legal_Jumps(struct Bitboard Pegs, struct Jump_Masks *Jumps)
+{
+ /*A bead on hole n can jump in direction d when hole n + d holds a bead &
+   hole n + 2d is an empty valid hole. Shifting the whole board by d lines
+   hole n + d up with hole n so every bead is tested at once:
+
+     From[d] = Pegs & shift(Pegs, d) & shift(Empty, 2d)
+ */
+
+ struct Bitboard Empty = Bitboard_And_Not(Valid_Holes, Pegs);
+
+
+ Jumps->From[Jump_Up]    = Bitboard_And(Bitboard_And(Pegs,
+                            Bitboard_Shift_Up(Pegs,  BOARD_STRIDE)),
+                            Bitboard_Shift_Up(Empty, 2 * BOARD_STRIDE));
+
+ Jumps->From[Jump_Down]  = Bitboard_And(Bitboard_And(Pegs,
+                            Bitboard_Shift_Down(Pegs,  BOARD_STRIDE)),
+                            Bitboard_Shift_Down(Empty, 2 * BOARD_STRIDE));
+
+ Jumps->From[Jump_Left]  = Bitboard_And(Bitboard_And(Pegs,
+                            Bitboard_Shift_Up(Pegs,  1)),
+                            Bitboard_Shift_Up(Empty, 2));
+
+ Jumps->From[Jump_Right] = Bitboard_And(Bitboard_And(Pegs,
+                            Bitboard_Shift_Down(Pegs,  1)),
+                            Bitboard_Shift_Down(Empty, 2));
+
+#if JUMP_DIRECTIONS == 6
+ Jumps->From[Jump_Up_Left]    = Bitboard_And(Bitboard_And(Pegs,
+                                 Bitboard_Shift_Up(Pegs,  BOARD_STRIDE + 1)),
+                                 Bitboard_Shift_Up(Empty, 2 * BOARD_STRIDE + 2));
+
+ Jumps->From[Jump_Down_Right] = Bitboard_And(Bitboard_And(Pegs,
+                                 Bitboard_Shift_Down(Pegs,  BOARD_STRIDE + 1)),
+                                 Bitboard_Shift_Down(Empty, 2 * BOARD_STRIDE + 2));
+#endif
+}
+
+
+/*FUNCTION:*/
+void Bitboard_Legal_Unjumps(struct Bitboard Pegs, struct Jump_Masks *Unjumps)
+{
+ /*The jumps that could have been made last, for searching backwards: bit n
+   of From[d] is set when holes n & n + d are empty & hole n + 2d holds a
+   bead. Bitboard_Toggle with the same from, over & to holes as the jump
+   takes it back, the bead on the to hole returns to the from hole & the
+   jumped bead reappears on the over hole*/
+
+ struct Bitboard Empty = Bitboard_And_Not(Valid_Holes, Pegs);
+
+
+ Unjumps->From[Jump_Up]    = Bitboard_And(Bitboard_And(Empty,
+                              Bitboard_Shift_Up(Empty, BOARD_STRIDE)),
+                              Bitboard_Shift_Up(Pegs,  2 * BOARD_STRIDE));
+
+ Unjumps->From[Jump_Down]  = Bitboard_And(Bitboard_And(Empty,
+                              Bitboard_Shift_Down(Empty, BOARD_STRIDE)),
+                              Bitboard_Shift_Down(Pegs,  2 * BOARD_STRIDE));
+
+ Unjumps->From[Jump_Left]  = Bitboard_And(Bitboard_And(Empty,
+                              Bitboard_Shift_Up(Empty, 1)),
+                              Bitboard_Shift_Up(Pegs,  2));
+
+ Unjumps->From[Jump_Right] = Bitboard_And(Bitboard_And(Empty,
+                              Bitboard_Shift_Down(Empty, 1)),
+                              Bitboard_Shift_Down(Pegs,  2));
+
+#if JUMP_DIRECTIONS == 6
+ Unjumps->From[Jump_Up_Left]    = Bitboard_And(Bitboard_And(Empty,
+                                   Bitboard_Shift_Up(Empty, BOARD_STRIDE + 1)),
+                                   Bitboard_Shift_Up(Pegs,  2 * BOARD_STRIDE + 2));
+
+ Unjumps->From[Jump_Down_Right] = Bitboard_And(Bitboard_And(Empty,
+                                   Bitboard_Shift_Down(Empty, BOARD_STRIDE + 1)),
+                                   Bitboard_Shift_Down(Pegs,  2 * BOARD_STRIDE + 2));
+#endif
+}
+
+
+/*FUNCTION:*/
+int Bitboard_Mobility(struct Bitboard Pegs)
+{
+ /*Total number of legal jumps in the position, 0 means stale mate*/
+
+ struct Jump_Masks Jumps;
+ int               Mobility;
+
+
+ Bitboard_Legal_Jumps(Pegs, &Jumps);
+
+ Mobility = Bitboard_Count(Jumps.From[Jump_Up])   +
+            Bitboard_Count(Jumps.From[Jump_Down]) +
+            Bitboard_Count(Jumps.From[Jump_Left]) +
+            Bitboard_Count(Jumps.From[Jump_Right]);
+
+#if JUMP_DIRECTIONS == 6
+ Mobility += Bitboard_Count(Jumps.From[Jump_Up_Left]) +
+             Bitboard_Count(Jumps.From[Jump_Down_Right]);
+#endif
+
+ return Mobility;
+}
+
+
+/*FUNCTION:*/
+void Bitboard_Mobility_Batch(const struct Bitboard *Boards, int Count,
+                             unsigned char *Mobility)
+{
+ /*Bitboard_Mobility of Count boards at once, for batch analysis. A board is
+   128 bits so 1 SSE2 register holds 1 & 1 AVX2 register holds 2, the same
+   shifts as Bitboard_Legal_Jumps then run on every board in the register.
+   The direction masks are counted with byte wise population counts (a 16
+   entry nibble table for AVX2, bit halving for SSE2) that are summed with 1
+   sum of absolute differences per register.
+
+   For a single board the scalar Bitboard_Legal_Jumps is quicker, moving the
+   2 words into a vector register & back costs more than the shifts save*/
+
+ int Board = 0;
+
+#if defined(PEG_ENGINE_AVX2)
+ const __m256i Valid  = _mm256_set_epi64x((long long) Valid_Holes.hi,
+                                          (long long) Valid_Holes.lo,
+                                          (long long) Valid_Holes.hi,
+                                          (long long) Valid_Holes.lo);
+ const __m256i Nibble = _mm256_set1_epi8(0x0f);
+ const __m256i Table  = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3,
+                                         1, 2, 2, 3, 2, 3, 3, 4,
+                                         0, 1, 1, 2, 1, 2, 2, 3,
+                                         1, 2, 2, 3, 2, 3, 3, 4);
+ __m256i       Pegs, Empty, Jumps, Bytes, Sums;
+
+
+ for (; Board + 2 <= Count; Board += 2)
+ {
+  Pegs  = _mm256_loadu_si256((const __m256i *) &Boards[Board]);
+  Empty = _mm256_andnot_si256(Pegs, Valid);
+  Bytes = _mm256_setzero_si256();
+
+  Jumps = _mm256_and_si256(Pegs, _mm256_and_si256(
+           SIMD_SHIFT_UP(Pegs, BOARD_STRIDE),
+           SIMD_SHIFT_UP(Empty, 2 * BOARD_STRIDE)));
+  Bytes = _mm256_add_epi8(Bytes, _mm256_add_epi8(
+           _mm256_shuffle_epi8(Table, _mm256_and_si256(Jumps, Nibble)),
+           _mm256_shuffle_epi8(Table, _mm256_and_si256(
+                                      _mm256_srli_epi16(Jumps, 4), Nibble))));
+
+  Jumps = _mm256_and_si256(Pegs, _mm256_and_si256(
+           SIMD_SHIFT_DOWN(Pegs, BOARD_STRIDE),
+           SIMD_SHIFT_DOWN(Empty, 2 * BOARD_STRIDE)));
+  Bytes = _mm256_add_epi8(Bytes, _mm256_add_epi8(
+           _mm256_shuffle_epi8(Table, _mm256_and_si256(Jumps, Nibble)),
+           _mm256_shuffle_epi8(Table, _mm256_and_si256(
+                                      _mm256_srli_epi16(Jumps, 4), Nibble))));
+
+  Jumps = _mm256_and_si256(Pegs, _mm256_and_si256(
+           SIMD_SHIFT_UP(Pegs, 1), SIMD_SHIFT_UP(Empty, 2)));
+  Bytes = _mm256_add_epi8(Bytes, _mm256_add_epi8(
+           _mm256_shuffle_epi8(Table, _mm256_and_si256(Jumps, Nibble)),
+           _mm256_shuffle_epi8(Table, _mm256_and_si256(
+                                      _mm256_srli_epi16(Jumps, 4), Nibble))));
+
+  Jumps = _mm256_and_si256(Pegs, _mm256_and_si256(
+           SIMD_SHIFT_DOWN(Pegs, 1), SIMD_SHIFT_DOWN(Empty, 2)));
+  Bytes = _mm256_add_epi8(Bytes, _mm256_add_epi8(
+           _mm256_shuffle_epi8(Table, _mm256_and_si256(Jumps, Nibble)),
+           _mm256_shuffle_epi8(Table, _mm256_and_si256(
+                                      _mm256_srli_epi16(Jumps, 4), Nibble))));
+
+#if JUMP_DIRECTIONS == 6
+  Jumps = _mm256_and_si256(Pegs, _mm256_and_si256(
+           SIMD_SHIFT_UP(Pegs, BOARD_STRIDE + 1),
+           SIMD_SHIFT_UP(Empty, 2 * BOARD_STRIDE + 2)));
+  Bytes = _mm256_add_epi8(Bytes, _mm256_add_epi8(
+           _mm256_shuffle_epi8(Table, _mm256_and_si256(Jumps, Nibble)),
+           _mm256_shuffle_epi8(Table, _mm256_and_si256(
+                                      _mm256_srli_epi16(Jumps, 4), Nibble))));
+
+  Jumps = _mm256_and_si256(Pegs, _mm256_and_si256(
+           SIMD_SHIFT_DOWN(Pegs, BOARD_STRIDE + 1),
+           SIMD_SHIFT_DOWN(Empty, 2 * BOARD_STRIDE + 2)));
+  Bytes = _mm256_add_epi8(Bytes, _mm256_add_epi8(
+           _mm256_shuffle_epi8(Table, _mm256_and_si256(Jumps, Nibble)),
+           _mm256_shuffle_epi8(Table, _mm256_and_si256(
+                                      _mm256_srli_epi16(Jumps, 4), Nibble))));
+#endif
+
+  /*4 words of byte sums, words 0 & 1 belong to the 1st board*/
+  Sums = _mm256_sad_epu8(Bytes, _mm256_setzero_si256());
+  Mobility[Board]     = (unsigned char) (_mm256_extract_epi64(Sums, 0) +
+                                         _mm256_extract_epi64(Sums, 1));
+  Mobility[Board + 1] = (unsigned char) (_mm256_extract_epi64(Sums, 2) +
+                                         _mm256_extract_epi64(Sums, 3));
+ }
+
+#elif defined(PEG_ENGINE_SSE2)
+ const __m128i Valid = _mm_set_epi64x((long long) Valid_Holes.hi,
+                                      (long long) Valid_Holes.lo);
+ const __m128i Ones  = _mm_set1_epi8(0x55);
+ const __m128i Twos  = _mm_set1_epi8(0x33);
+ const __m128i Fours = _mm_set1_epi8(0x0f);
+ __m128i       Pegs, Empty, Jumps, Bytes, Sums;
+ int           Direction;
+
+
+ for (; Board < Count; Board++)
+ {
+  Pegs  = _mm_loadu_si128((const __m128i *) &Boards[Board]);
+  Empty = _mm_andnot_si128(Pegs, Valid);
+  Bytes = _mm_setzero_si128();
+
+  for (Direction = Jump_Up; Direction < JUMP_DIRECTIONS; Direction++)
+  {
+   switch (Direction)
+   {
+    case Jump_Up:
+         Jumps = _mm_and_si128(SIMD_SHIFT_UP(Pegs, BOARD_STRIDE),
+                               SIMD_SHIFT_UP(Empty, 2 * BOARD_STRIDE));
+    break;
+
+    case Jump_Down:
+         Jumps = _mm_and_si128(SIMD_SHIFT_DOWN(Pegs, BOARD_STRIDE),
+                               SIMD_SHIFT_DOWN(Empty, 2 * BOARD_STRIDE));
+    break;
+
+    case Jump_Left:
+         Jumps = _mm_and_si128(SIMD_SHIFT_UP(Pegs, 1),
+                               SIMD_SHIFT_UP(Empty, 2));
+    break;
+
+    case Jump_Right:
+         Jumps = _mm_and_si128(SIMD_SHIFT_DOWN(Pegs, 1),
+                               SIMD_SHIFT_DOWN(Empty, 2));
+    break;
+
+    case Jump_Up_Left:
+         Jumps = _mm_and_si128(SIMD_SHIFT_UP(Pegs, BOARD_STRIDE + 1),
+                               SIMD_SHIFT_UP(Empty, 2 * BOARD_STRIDE + 2));
+    break;
+
+    default:
+         Jumps = _mm_and_si128(SIMD_SHIFT_DOWN(Pegs, BOARD_STRIDE + 1),
+                               SIMD_SHIFT_DOWN(Empty, 2 * BOARD_STRIDE + 2));
+    break;
+   }
+
+   /*Bit halving: 2 bit, 4 bit then 8 bit counts*/
+   Jumps = _mm_and_si128(Jumps, Pegs);
+   Jumps = _mm_sub_epi8(Jumps, _mm_and_si128(_mm_srli_epi16(Jumps, 1), Ones));
+   Jumps = _mm_add_epi8(_mm_and_si128(Jumps, Twos),
+                        _mm_and_si128(_mm_srli_epi16(Jumps, 2), Twos));
+   Bytes = _mm_add_epi8(Bytes,
+            _mm_and_si128(_mm_add_epi8(Jumps, _mm_srli_epi16(Jumps, 4)),
+                          Fours));
+  }
+
+  Sums = _mm_sad_epu8(Bytes, _mm_setzero_si128());
+  Mobility[Board] = (unsigned char) (_mm_cvtsi128_si32(Sums) +
+                                     _mm_cvtsi128_si32(_mm_srli_si128(Sums, 8)));
+ }
+#endif
+
+ /*Scalar build & the odd board left over by AVX2*/
+ for (; Board < Count; Board++)
+    Mobility[Board] = (unsigned char) Bitboard_Mobility(Boards[Board]);
+}
+
+
+/*FUNCTION:*/
+int Bitboard_Jump(struct Bitboard *Pegs, int From, int To)
+{
+ /*Validates a jump from hole From to hole To & applies it by toggling the 3
+   holes involved. Returns 1 for a valid jump & 0 when the board is left
+   untouched*/
+
+ int Jump = Jump_Find(From, To);
+
+
+ if (Jump < 0 ||
+     !Bitboard_Test(*Pegs, Jump_Table[Jump].From) ||
+     !Bitboard_Test(*Pegs, Jump_Table[Jump].Over) ||
+      Bitboard_Test(*Pegs, Jump_Table[Jump].To))
+   return 0;
+
+ *Pegs = Bitboard_Toggle(*Pegs, Jump_Table[Jump].From, Jump_Table[Jump].Over,
+                         Jump_Table[Jump].To);
+ return 1;
+}
+
+
+/*FUNCTION:*/
+int Jump_Find(int From, int To)
+{
+ /*Index into Jump_Table of the jump from hole From to hole To, -1 when the
+   board has no such jump. Only the at most JUMP_DIRECTIONS jumps of From
+   are looked at*/
+
+ int Jump;
+
+
+ if (From < 0 || From >= BOARD_BITS)
+   return -1;
+
+ for (Jump = Jump_First[From]; Jump < Jump_First[From + 1]; Jump++)
+    if (Jump_Table[Jump].To == To)
+      return Jump;
+
+ return -1;
+}
+
+
+/*FUNCTION:*/
+int Jump_Generate(struct Bitboard Pegs, unsigned char Moves[JUMP_COUNT])
+{
+ /*Writes the Jump_Table indices of every legal jump to Moves & returns how
+   many there are, 0 means stale mate. Each index is stored unconditionally
+   & the count only advances when the jump is legal, so the loop has no
+   branch on the board*/
+
+ int Jump, Count = 0;
+
+
+ for (Jump = 0; Jump < JUMP_COUNT; Jump++)
+ {
+  Moves[Count] = (unsigned char) Jump;
+  Count       += Bitboard_Test(Pegs, Jump_Table[Jump].From) &
+                 Bitboard_Test(Pegs, Jump_Table[Jump].Over) &
+                 (Bitboard_Test(Pegs, Jump_Table[Jump].To) ^ 1);
+ }
+
+ return Count;
+}
+
+
+/*FUNCTION:*/
+int Bitboard_Is_Won(struct Bitboard Pegs)
+{
+ /*1 bead left & it is on the finish, the centre hole board[4][4] of the
+   cross*/
+ return Bitboard_Equal(Pegs, Bitboard_Bit(BOARD_CENTRE));
+}
+
+
+/*FUNCTION:*/
+uint64_t Bitboard_Pack(struct Bitboard Pegs)
+{
+ /*Squeezes the BOARD_HOLES holes into the low bits of 1 word (0 to 44 on the
+   cross), reading the board row by row. The packed form is an exact key for
+   hash tables & save files*/
+
+#ifdef PEG_ENGINE_BMI2
+ return _pext_u64(Pegs.lo, Valid_Holes.lo) |
+        _pext_u64(Pegs.hi, Valid_Holes.hi) << POPCOUNT64(Valid_Holes.lo);
+#else
+ uint64_t Packed = 0, Row_Bits;
+ int      Row, Shift = 0;
+
+
+ for (Row = 0; Row < BOARD_SIZE; Row++)
+ {
+  if (Row_First_Hole[Row] >= 64)
+    Row_Bits = Pegs.hi >> (Row_First_Hole[Row] - 64);
+  else
+    Row_Bits = (Pegs.lo >> Row_First_Hole[Row]) |
+               (Pegs.hi << 1 << (63 - Row_First_Hole[Row]));
+
+  Packed |= (Row_Bits & ((1u << Row_Width[Row]) - 1)) << Shift;
+  Shift  += Row_Width[Row];
+ }
+
+ return Packed;
+#endif
+}
+
+
+/*FUNCTION:*/
+struct Bitboard Bitboard_Unpack(uint64_t Packed)
+{
+ struct Bitboard Pegs = {0, 0};
+#ifdef PEG_ENGINE_BMI2
+
+
+ Pegs.lo = _pdep_u64(Packed, Valid_Holes.lo);
+ Pegs.hi = _pdep_u64(Packed >> POPCOUNT64(Valid_Holes.lo), Valid_Holes.hi);
+#else
+ uint64_t        Row_Bits;
+ int             Row;
+
+
+ for (Row = 0; Row < BOARD_SIZE; Row++)
+ {
+  Row_Bits = Packed & ((1u << Row_Width[Row]) - 1);
+  Packed >>= Row_Width[Row];
+
+  if (Row_First_Hole[Row] >= 64)
+    Pegs.hi |= Row_Bits << (Row_First_Hole[Row] - 64);
+  else
+  {
+   Pegs.lo |= Row_Bits << Row_First_Hole[Row];
+   Pegs.hi |= Row_Bits >> 1 >> (63 - Row_First_Hole[Row]);
+  }
+ }
+#endif
+
+ return Pegs;
+}
+
+
+/*FUNCTION:*/
+void Symmetry_Init(void)
+{
+ /*Builds the bit permutation tables of the BOARD_SYMMETRIES symmetries of the
+   board, the 8 of the square on the cross. Must run once before
+   Symmetry_Transform / Symmetry_Canonical, calling it again does nothing. Not
+   thread safe: call it before starting any threads*/
+
+ unsigned char Pack_Row[BOARD_HOLES], Pack_Col[BOARD_HOLES];
+ signed char   Pack_Of[BOARD_SIZE][BOARD_SIZE];
+ int           Row, Col, Image_Row, Image_Col, Hole, Symmetry, Byte, Value, Bit;
+
+
+ if (Symmetry_Ready) return;
+
+ for (Row = 0; Row < BOARD_SIZE; Row++)
+    for (Col = 0; Col < BOARD_SIZE; Col++)
+       Pack_Of[Row][Col] = -1;
+
+ /*Packed bit n is the n-th valid hole in row by row order*/
+ for (Row = 0, Hole = 0; Row < BOARD_SIZE; Row++)
+    for (Col = 0; Col < BOARD_SIZE; Col++)
+       if (Bitboard_Test(Valid_Holes, HOLE_INDEX(Row, Col)))
+       {
+        Pack_Row[Hole]    = Row;
+        Pack_Col[Hole]    = Col;
+        Pack_Of[Row][Col] = Hole++;
+       }
+
+ for (Symmetry = 0; Symmetry < BOARD_SYMMETRIES; Symmetry++)
+    for (Byte = 0; Byte < 6; Byte++)
+       for (Value = 0; Value < 256; Value++)
+       {
+        Symmetry_Table[Symmetry][Byte][Value] = 0;
+
+        for (Bit = 0; Bit < 8; Bit++)
+        {
+         Hole = Byte * 8 + Bit;
+         if (!(Value >> Bit & 1) || Hole >= BOARD_HOLES) continue;
+
+         Row = Pack_Row[Hole];
+         Col = Pack_Col[Hole];
+
+         switch (Symmetry_Kind[Symmetry])
+         {
+          case 0: Image_Row = Row;     Image_Col = Col;     break; /*identity*/
+          case 1: Image_Row = Col;     Image_Col = 8 - Row; break; /*rotate 90*/
+          case 2: Image_Row = 8 - Row; Image_Col = 8 - Col; break; /*rotate 180*/
+          case 3: Image_Row = 8 - Col; Image_Col = Row;     break; /*rotate 270*/
+          case 4: Image_Row = Row;     Image_Col = 8 - Col; break; /*mirror left right*/
+          case 5: Image_Row = 8 - Row; Image_Col = Col;     break; /*mirror top bottom*/
+          case 6: Image_Row = Col;     Image_Col = Row;     break; /*mirror diagonal*/
+          default: Image_Row = 8 - Col; Image_Col = 8 - Row; break; /*mirror anti diagonal*/
+         }
+
+         Symmetry_Table[Symmetry][Byte][Value] |=
+                               (uint64_t) 1 << Pack_Of[Image_Row][Image_Col];
+        }
+       }
+
+ Symmetry_Ready = 1;
+}
+
+
+/*FUNCTION:*/
+uint64_t Symmetry_Transform(int Symmetry, uint64_t Packed)
+{
+ return Symmetry_Table[Symmetry][0][Packed       & 0xff] |
+        Symmetry_Table[Symmetry][1][Packed >>  8 & 0xff] |
+        Symmetry_Table[Symmetry][2][Packed >> 16 & 0xff] |
+        Symmetry_Table[Symmetry][3][Packed >> 24 & 0xff] |
+        Symmetry_Table[Symmetry][4][Packed >> 32 & 0xff] |
+        Symmetry_Table[Symmetry][5][Packed >> 40 & 0xff];
+}
+
+
+/*FUNCTION:*/
+uint64_t Symmetry_Canonical(uint64_t Packed)
+{
+ /*The smallest of the BOARD_SYMMETRIES symmetric images. Positions that are
+   rotations or reflections of each other share it, and so share 1 table
+   entry. The finish is fixed by every symmetry of Symmetry_Kind so
+   solvability is unchanged*/
+
+ uint64_t Canonical = Packed, Image;
+ int      Symmetry;
+
+
+ for (Symmetry = 1; Symmetry < BOARD_SYMMETRIES; Symmetry++)
+ {
+  Image = Symmetry_Transform(Symmetry, Packed);
+  if (Image < Canonical) Canonical = Image;
+ }
+
+ return Canonical;
+}
+
+
+/*FUNCTION:*/
+uint64_t Zobrist_Hash(struct Bitboard Pegs)
+{
+ /*Full hash of a position, only needed when a board is set up or loaded.
+   After that Zobrist_Jump keeps the hash up to date*/
+
+ uint64_t Key = 0;
+
+
+ Pegs = Bitboard_And(Pegs, Valid_Holes);
+ while (!Bitboard_Is_Empty(Pegs))
+    Key ^= Zobrist_Keys[Bitboard_Pop(&Pegs)];
+
+ return Key;
+}
@@ -0,0 +1,255 @@
+/*Date:    17Oct2026Sat 09:12
+//File:    peg_engine.h
+//Desc:    Packed bitboard representation of the 9x9 cross board used by the
+           Peg Solitaire front ends. Every hole is 1 bit, a whole position is
+           2 64 bit words and the rules (move generation, jumping & the win
+           test) are shift / AND / OR operations on those words.
+
+           Bit layout: index = row * BOARD_STRIDE + col. Column 9 of every row
+           is padding which is never a valid hole, so shifting a row left or
+           right never carries a bead into the neighbouring row.
+
+                 0  1  2  3  4  5  6  7  8  pad
+              0  .  .  .  3  4  5  .  .  .   9
+              1  .  .  . 13 14 15  .  .  .  19
+              2  .  .  . 23 24 25  .  .  .  29
+              3 30 31 32 33 34 35 36 37 38  39
+              4 40 41 42 43 44 45 46 47 48  49
+              5 50 51 52 53 54 55 56 57 58  59
+              6  .  .  . 63 64 65  .  .  .  69
+              7  .  .  . 73 74 75  .  .  .  79
+              8  .  .  . 83 84 85  .  .  .  89
+
+           That is the cross, the default. The other boards of
+           peg_geometry.h use the same grid & padding, only which holes are
+           valid & the jumps differ.
+*/
+
+
+#ifndef PEG_ENGINE_H
+#define PEG_ENGINE_H
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include <stdint.h>
+#include "peg_geometry.h" /*BOARD_HOLES, BOARD_CENTRE, JUMP_COUNT...*/
+
+#define BOARD_SIZE      9
+#define BOARD_STRIDE   10
+#define BOARD_BITS     90
+
+#define HOLE_INDEX(Row, Col) ((Row) * BOARD_STRIDE + (Col))
+
+/*Population count & count trailing zeros, plain C for compilers such as tcc
+  that lack the gcc builtins*/
+#if defined(__GNUC__) || defined(__clang__)
+#define POPCOUNT64(x) __builtin_popcountll(x)
+#define CTZ64(x)      __builtin_ctzll(x)
+#else
+#define POPCOUNT64(x) Popcount64(x)
+#define CTZ64(x)      Popcount64(((x) & -(x)) - 1)
+
+static inline int Popcount64(uint64_t x)
+{
+ x = x - ((x >> 1) & 0x5555555555555555ULL);
+ x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+ x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+ return (int) ((x * 0x0101010101010101ULL) >> 56);
+}
+#endif
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+struct Bitboard
+{
+ uint64_t lo, /*bits  0 to 63*/
+          hi; /*bits 64 to 89*/
+};
+
+/*The jump directions, a jump goes from -> over -> to along one of them. The
+  first JUMP_DIRECTIONS are used, the diagonals only on the triangle*/
+enum Jump_Direction {Jump_Up, Jump_Down, Jump_Left, Jump_Right, Jump_Up_Left,
+                     Jump_Down_Right};
+
+/*1 jump as bit indices, see HOLE_INDEX*/
+struct Jump
+{
+ unsigned char From, Over, To;
+};
+
+/*Legal jumps of a position: bit n of From[d] is set when the bead on hole n
+  can jump in direction d. Also the jumps that can be taken back, see
+  Bitboard_Legal_Unjumps*/
+struct Jump_Masks
+{
+ struct Bitboard From[JUMP_DIRECTIONS];
+};
+
+
+/*----------------------------
+//Global Variable Declarations
+----------------------------*/
+extern const struct Bitboard Valid_Holes; /*the BOARD_HOLES of the board*/
+extern const struct Bitboard Start_Pegs;  /*every hole but 1*/
+extern const int             Jump_Offset[JUMP_DIRECTIONS];
+extern const uint64_t        Zobrist_Keys[BOARD_BITS];
+extern const struct Jump     Jump_Table[JUMP_COUNT];
+extern const unsigned char   Jump_First[BOARD_BITS + 1];
+extern const char * const    Board_Picture[BOARD_PICTURE_LINES];
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+void Bitboard_Legal_Jumps(struct Bitboard Pegs, struct Jump_Masks *Jumps);
+void Bitboard_Legal_Unjumps(struct Bitboard Pegs, struct Jump_Masks *Unjumps);
+int  Bitboard_Mobility(struct Bitboard Pegs);
+void Bitboard_Mobility_Batch(const struct Bitboard *Boards, int Count,
+                             unsigned char *Mobility);
+int  Bitboard_Jump(struct Bitboard *Pegs, int From, int To);
+int  Bitboard_Is_Won(struct Bitboard Pegs);
+int  Jump_Find(int From, int To);
+int  Jump_Generate(struct Bitboard Pegs, unsigned char Moves[JUMP_COUNT]);
+uint64_t        Bitboard_Pack(struct Bitboard Pegs);
+struct Bitboard Bitboard_Unpack(uint64_t Packed);
+void            Symmetry_Init(void);
+uint64_t        Symmetry_Transform(int Symmetry, uint64_t Packed);
+uint64_t        Symmetry_Canonical(uint64_t Packed);
+uint64_t        Zobrist_Hash(struct Bitboard Pegs);
+
+
+/*--------------------
+//Inline Definitions (the hot bit operations)
+--------------------*/
+static inline struct Bitboard Bitboard_Bit(int Index)
+{
+ struct Bitboard Result;
+
+
+ Result.lo = Index <  64 ? (uint64_t) 1 << Index        : 0;
+ Result.hi = Index >= 64 ? (uint64_t) 1 << (Index - 64) : 0;
+ return Result;
+}
+
+
+static inline int Bitboard_Test(struct Bitboard Board, int Index)
+{
+ if (Index < 64) return (int) ((Board.lo >> Index) & 1);
+ return (int) ((Board.hi >> (Index - 64)) & 1);
+}
+
+
+static inline struct Bitboard Bitboard_And(struct Bitboard A, struct Bitboard B)
+{
+ A.lo &= B.lo;
+ A.hi &= B.hi;
+ return A;
+}
+
+
+static inline struct Bitboard Bitboard_Or(struct Bitboard A, struct Bitboard B)
+{
+ A.lo |= B.lo;
+ A.hi |= B.hi;
+ return A;
+}
+
+
+static inline struct Bitboard Bitboard_Xor(struct Bitboard A, struct Bitboard B)
+{
+ A.lo ^= B.lo;
+ A.hi ^= B.hi;
+ return A;
+}
+
+
+/*A & ~B*/
+static inline struct Bitboard Bitboard_And_Not(struct Bitboard A,
+                                               struct Bitboard B)
+{
+ A.lo &= ~B.lo;
+ A.hi &= ~B.hi;
+ return A;
+}
+
+
+/*Moves every bit Count places towards bit 89, 0 < Count < 64*/
+static inline struct Bitboard Bitboard_Shift_Up(struct Bitboard A, int Count)
+{
+ A.hi = (A.hi << Count) | (A.lo >> (64 - Count));
+ A.lo <<= Count;
+ return A;
+}
+
+
+/*Moves every bit Count places towards bit 0, 0 < Count < 64*/
+static inline struct Bitboard Bitboard_Shift_Down(struct Bitboard A, int Count)
+{
+ A.lo = (A.lo >> Count) | (A.hi << (64 - Count));
+ A.hi >>= Count;
+ return A;
+}
+
+
+static inline int Bitboard_Is_Empty(struct Bitboard A)
+{
+ return (A.lo | A.hi) == 0;
+}
+
+
+static inline int Bitboard_Equal(struct Bitboard A, struct Bitboard B)
+{
+ return A.lo == B.lo && A.hi == B.hi;
+}
+
+
+static inline int Bitboard_Count(struct Bitboard A)
+{
+ return POPCOUNT64(A.lo) + POPCOUNT64(A.hi);
+}
+
+
+/*Makes a legal jump or unmakes the jump just made: the from, over & to holes
+  all change state so the same XOR does both, no copy of the board needed*/
+static inline struct Bitboard Bitboard_Toggle(struct Bitboard Pegs, int From,
+                                              int Over, int To)
+{
+ return Bitboard_Xor(Pegs, Bitboard_Or(Bitboard_Or(Bitboard_Bit(From),
+                                                   Bitboard_Bit(Over)),
+                                       Bitboard_Bit(To)));
+}
+
+
+/*Hash after a jump: the from, over & to holes all change state so their 3
+  keys are XOR-ed in or out, the jump undone the same way*/
+static inline uint64_t Zobrist_Jump(uint64_t Key, int From, int Over, int To)
+{
+ return Key ^ Zobrist_Keys[From] ^ Zobrist_Keys[Over] ^ Zobrist_Keys[To];
+}
+
+
+/*Returns the lowest set bit & clears it, the board must not be empty*/
+static inline int Bitboard_Pop(struct Bitboard *A)
+{
+ int Index;
+
+
+ if (A->lo)
+ {
+  Index  = CTZ64(A->lo);
+  A->lo &= A->lo - 1;
+ }
+ else
+ {
+  Index  = 64 + CTZ64(A->hi);
+  A->hi &= A->hi - 1;
+ }
+
+ return Index;
+}
+
+#endif
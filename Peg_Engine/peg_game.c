@@ -0,0 +1,137 @@
+/*Date:    17Oct2026Sat 15:40
+//File:    peg_game.c
+//Desc:    The rules applied to a struct Peg_Game, see peg_game.h.
+*/
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include "peg_game.h"
+
+
+/*--------------------
+//Function Definitions (Implementation)
+--------------------*/
+
+
+/*FUNCTION:*/
+void Game_Init(struct Peg_Game *Game)
+{
+ /*Every hole of the board holds a bead except 1, on the cross the central
+   hole, the cursor starts on the finish*/
+
+ Game->Pegs         = Start_Pegs;
+ Game->Key          = Zobrist_Hash(Game->Pegs);
+ Game->Beads        = BOARD_HOLES - 1;
+ Game->Cursor_Row   = BOARD_CENTRE / BOARD_STRIDE;
+ Game->Cursor_Col   = BOARD_CENTRE % BOARD_STRIDE;
+ Game->Selected_Row = GAME_NONE;
+ Game->Selected_Col = GAME_NONE;
+ Game->Moves_Made   = Game->Moves_Logged = 0;
+}
+
+
+/*FUNCTION:*/
+void Game_Move_Cursor(struct Peg_Game *Game, int Row_Step, int Col_Step)
+{
+ /*Steps the cursor to the next hole of the board in that direction, from an
+   edge it wraps around to the far end of its row or column*/
+
+ do
+ {
+  Game->Cursor_Row = (Game->Cursor_Row + Row_Step + BOARD_SIZE) % BOARD_SIZE;
+  Game->Cursor_Col = (Game->Cursor_Col + Col_Step + BOARD_SIZE) % BOARD_SIZE;
+ }
+ while (!Bitboard_Test(Valid_Holes,
+                       HOLE_INDEX(Game->Cursor_Row, Game->Cursor_Col)));
+}
+
+
+/*FUNCTION:*/
+int Game_Legal_Moves(const struct Peg_Game *Game,
+                     unsigned char Moves[JUMP_COUNT])
+{
+ /*Jump_Table indices of the legal jumps, returns how many*/
+
+ return Jump_Generate(Game->Pegs, Moves);
+}
+
+
+/*FUNCTION:*/
+int Game_Apply(struct Peg_Game *Game, int From, int To)
+{
+ /*Makes the jump From -> To when it is legal & logs it for undo, a new jump
+   drops whatever was left to redo. Returns 1 when the jump was made*/
+
+ struct Jump *Move;
+
+
+ if (!Bitboard_Jump(&Game->Pegs, From, To))
+   return 0;
+
+ Move       = &Game->Move_Log[Game->Moves_Made];
+ Move->From = From;
+ Move->Over = (From + To) / 2;
+ Move->To   = To;
+
+ Game->Key          = Zobrist_Jump(Game->Key, Move->From, Move->Over, Move->To);
+ Game->Beads--;
+ Game->Moves_Logged = ++Game->Moves_Made;
+ return 1;
+}
+
+
+/*FUNCTION:*/
+int Game_Undo(struct Peg_Game *Game)
+{
+ /*Takes back the last jump by toggling its 3 holes again, the jump stays in
+   Move_Log so Game_Redo can make it again. Returns 0 with nothing to undo*/
+
+ struct Jump Move;
+
+
+ if (Game->Moves_Made == 0)
+   return 0;
+
+ Move       = Game->Move_Log[--Game->Moves_Made];
+ Game->Pegs = Bitboard_Toggle(Game->Pegs, Move.From, Move.Over, Move.To);
+ Game->Key  = Zobrist_Jump(Game->Key, Move.From, Move.Over, Move.To);
+ Game->Beads++;
+ return 1;
+}
+
+
+/*FUNCTION:*/
+int Game_Redo(struct Peg_Game *Game)
+{
+ /*Returns 0 with nothing to redo*/
+
+ struct Jump Move;
+
+
+ if (Game->Moves_Made == Game->Moves_Logged)
+   return 0;
+
+ Move       = Game->Move_Log[Game->Moves_Made++];
+ Game->Pegs = Bitboard_Toggle(Game->Pegs, Move.From, Move.Over, Move.To);
+ Game->Key  = Zobrist_Jump(Game->Key, Move.From, Move.Over, Move.To);
+ Game->Beads--;
+ return 1;
+}
+
+
+/*FUNCTION:*/
+int Game_Is_Won(const struct Peg_Game *Game)
+{
+ return Bitboard_Is_Won(Game->Pegs);
+}
+
+
+/*FUNCTION:*/
+int Game_Is_Stalemate(const struct Peg_Game *Game)
+{
+ /*No legal jump left without having won*/
+
+ return !Bitboard_Is_Won(Game->Pegs) && Bitboard_Mobility(Game->Pegs) == 0;
+}
@@ -0,0 +1,64 @@
+/*Date:    17Oct2026Sat 15:40
+//File:    peg_game.h
+//Desc:    1 game of Peg Solitaire as a value: the board, its hash, cursor,
+           selection & the undo / redo log all live in struct Peg_Game so a
+           process can hold as many independent games as it has memory for
+           & play or benchmark them without a terminal. Every function takes
+           the game it works on, none keeps state of its own. The save file
+           of peg_save.h is the serialized form of a Peg_Game.
+
+           Built as a static library that both front ends link against:
+            cd Peg_Engine
+            gcc -c -O2 -Wall -Wextra -pthread peg_engine.c peg_command.c peg_solver.c peg_database.c peg_rank.c peg_pagoda.c peg_stats.c peg_journal.c peg_save.c peg_game.c peg_large.c peg_count.c
+            ar rcs libpeg_engine.a peg_engine.o peg_command.o peg_solver.o peg_database.o peg_rank.o peg_pagoda.o peg_stats.o peg_journal.o peg_save.o peg_game.o peg_large.o peg_count.o
+           then from the front end directories
+            gcc -Wall -Wextra peg_solitaire.c -LPeg_Engine -lpeg_engine -pthread -o peg_solitaire
+            gcc -Wall -Wextra `ncursesw6-config --cflags` peg_solitaire_ncurses.c -L../Peg_Engine -lpeg_engine `ncursesw6-config --libs` -o peg_solitaire_ncurses
+*/
+
+
+#ifndef PEG_GAME_H
+#define PEG_GAME_H
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include "peg_engine.h"
+
+#define GAME_NONE 255 /*Selected_Row & Selected_Col when no bead is selected*/
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+struct Peg_Game
+{
+ struct Bitboard Pegs;         /*1 bit per hole, see peg_engine.h*/
+ uint64_t        Key;          /*Zobrist hash of Pegs, kept up to date by jumps*/
+ int             Beads,        /*Bitboard_Count(Pegs)*/
+                 Cursor_Row,
+                 Cursor_Col,
+                 Selected_Row, /*GAME_NONE when no bead is selected*/
+                 Selected_Col,
+                 Moves_Made,   /*jumps on the board, undo takes back n - 1*/
+                 Moves_Logged; /*jumps in Move_Log, the ones past Moves_Made
+                                 are redo*/
+ struct Jump     Move_Log[BOARD_HOLES]; /*jumps of this game, 3 bytes each*/
+};
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+void Game_Init(struct Peg_Game *Game);
+void Game_Move_Cursor(struct Peg_Game *Game, int Row_Step, int Col_Step);
+int  Game_Legal_Moves(const struct Peg_Game *Game,
+                      unsigned char Moves[JUMP_COUNT]);
+int  Game_Apply(struct Peg_Game *Game, int From, int To);
+int  Game_Undo(struct Peg_Game *Game);
+int  Game_Redo(struct Peg_Game *Game);
+int  Game_Is_Won(const struct Peg_Game *Game);
+int  Game_Is_Stalemate(const struct Peg_Game *Game);
+
+#endif
@@ -0,0 +1,85 @@
+/*Date:    17Oct2026Sat 22:05
+//File:    peg_geometry.h
+//Desc:    The board an engine is built for, picked at compile time:
+            gcc -DPEG_GEOMETRY=GEOMETRY_ENGLISH ...
+           Without the flag it is the 45 hole cross. Every board sits centred
+           in the same 9x9 grid of peg_engine.h so the bit layout, the shifts
+           & the packing are shared; Valid_Holes, Start_Pegs, Jump_Table &
+           Board_Picture are constants of peg_engine.c chosen by #if, so a
+           build knows only its own board & tests nothing at run time.
+
+            cross     45 holes, arms 3 wide & 3 long. Start & finish on
+                      board[4][4]
+            english   33 holes, arms 3 wide & 2 long, rows & columns 1 to 7
+                      of the grid. Start & finish on board[4][4]
+            european  37 holes, the English board with 4 more holes in the
+                      corners between the arms. No board of 1 hole empty can
+                      finish on the centre (see the position classes of
+                      peg_pagoda.h), it starts with board[2][4] empty &
+                      finishes on board[6][4]
+            triangle  15 holes in rows of 1 to 5 beads, drawn as a staircase
+                      in rows & columns 2 to 6 with col <= row. Jumps also
+                      run along the diagonal, up left & down right. Start &
+                      finish on the apex board[2][2]
+
+           BOARD_CENTRE is the hole of the finish, on the cross the centre.
+           A save file or database made on 1 board is refused by a build for
+           another.
+*/
+
+
+#ifndef PEG_GEOMETRY_H
+#define PEG_GEOMETRY_H
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#define GEOMETRY_CROSS    0
+#define GEOMETRY_ENGLISH  1
+#define GEOMETRY_EUROPEAN 2
+#define GEOMETRY_TRIANGLE 3
+
+#ifndef PEG_GEOMETRY
+#define PEG_GEOMETRY GEOMETRY_CROSS
+#endif
+
+#if PEG_GEOMETRY == GEOMETRY_CROSS
+#define GEOMETRY_NAME    "cross"
+#define BOARD_HOLES      45
+#define BOARD_CENTRE     44  /*board[4][4]*/
+#define JUMP_COUNT       108 /*directed jumps that fit on the board*/
+#define JUMP_DIRECTIONS  4
+#define BOARD_SYMMETRIES 8   /*4 rotations x 2 reflections of the square*/
+
+#elif PEG_GEOMETRY == GEOMETRY_ENGLISH
+#define GEOMETRY_NAME    "english"
+#define BOARD_HOLES      33
+#define BOARD_CENTRE     44  /*board[4][4]*/
+#define JUMP_COUNT       76
+#define JUMP_DIRECTIONS  4
+#define BOARD_SYMMETRIES 8
+
+#elif PEG_GEOMETRY == GEOMETRY_EUROPEAN
+#define GEOMETRY_NAME    "european"
+#define BOARD_HOLES      37
+#define BOARD_CENTRE     64  /*board[6][4]*/
+#define JUMP_COUNT       92
+#define JUMP_DIRECTIONS  4
+#define BOARD_SYMMETRIES 2   /*only the left right mirror keeps the finish*/
+
+#elif PEG_GEOMETRY == GEOMETRY_TRIANGLE
+#define GEOMETRY_NAME    "triangle"
+#define BOARD_HOLES      15
+#define BOARD_CENTRE     22  /*board[2][2], the apex*/
+#define JUMP_COUNT       36
+#define JUMP_DIRECTIONS  6
+#define BOARD_SYMMETRIES 1   /*the staircase is no square, none used*/
+
+#else
+#error "PEG_GEOMETRY is not one of the GEOMETRY_ boards"
+#endif
+
+#define BOARD_PICTURE_LINES 21 /*of Board_Picture, 2 per row & 3 more*/
+
+#endif
@@ -0,0 +1,272 @@
+/*Date:    17Oct2026Sat 21:20
+//File:    peg_journal.c
+//Desc:    Writes & reads the input journal of peg_journal.h. Each record is
+           flushed as it is written so the journal of a session that crashes
+           holds every input up to the crash.
+*/
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#define _POSIX_C_SOURCE 200112L /*clock_gettime, nanosleep*/
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include "peg_journal.h"
+
+#define JOURNAL_HEADER 6
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+static void Journal_Put(FILE *File, uint64_t Value);
+static int  Journal_Get(FILE *File, uint64_t *Value);
+
+
+/*--------------------
+//Function Definitions (Implementation)
+--------------------*/
+
+
+/*FUNCTION:*/
+int Journal_Create(struct Peg_Journal *Journal, const char *Path, int Kind)
+{
+ /*Starts a journal at Path, replacing what is there. Returns 0 when the
+   file cannot be written*/
+
+ unsigned char Header[JOURNAL_HEADER] = {'P', 'E', 'G', 'J', JOURNAL_VERSION};
+
+
+ Header[5] = (unsigned char) Kind;
+
+ memset(Journal, 0, sizeof(*Journal));
+ Journal->Kind    = Kind;
+ Journal->Version = JOURNAL_VERSION;
+ Journal->Writing = 1;
+
+ if ((Journal->File = fopen(Path, "wb")) == NULL) return 0;
+
+ if (fwrite(Header, 1, JOURNAL_HEADER, Journal->File) != JOURNAL_HEADER ||
+     fflush(Journal->File) != 0)
+ {
+  fclose(Journal->File);
+  Journal->File = NULL;
+  return 0;
+ }
+
+ Journal->Last = Journal_Clock();
+ return 1;
+}
+
+
+/*FUNCTION:*/
+int Journal_Open(struct Peg_Journal *Journal, const char *Path)
+{
+ /*Opens the journal at Path for replay, only a known magic & version are
+   accepted. The kind is left in Journal->Kind & the version in
+   Journal->Version*/
+
+ unsigned char Header[JOURNAL_HEADER];
+
+
+ memset(Journal, 0, sizeof(*Journal));
+
+ if ((Journal->File = fopen(Path, "rb")) == NULL) return 0;
+
+ if (fread(Header, 1, JOURNAL_HEADER, Journal->File) != JOURNAL_HEADER ||
+     memcmp(Header, "PEGJ", 4) != 0 || Header[4] < 1 ||
+     Header[4] > JOURNAL_VERSION ||
+     Header[5] > Journal_Keys)
+ {
+  fclose(Journal->File);
+  Journal->File = NULL;
+  return 0;
+ }
+
+ Journal->Kind    = Header[5];
+ Journal->Version = Header[4];
+ Journal->Last    = Journal_Clock();
+ return 1;
+}
+
+
+/*FUNCTION:*/
+int Journal_Write(struct Peg_Journal *Journal, const uint64_t *Values,
+                  int Count)
+{
+ /*Appends 1 input of Count (1 to JOURNAL_VALUES) values stamped with the
+   time since the last one*/
+
+ uint64_t Now = Journal_Clock();
+ int      Value;
+
+
+ if (Journal->File == NULL || Count < 1 || Count > JOURNAL_VALUES) return 0;
+
+ Journal_Put(Journal->File, Now - Journal->Last);
+ Journal_Put(Journal->File, (uint64_t) Count);
+ for (Value = 0; Value < Count; Value++)
+    Journal_Put(Journal->File, Values[Value]);
+
+ Journal->Last = Now;
+ Journal->Records++;
+ return fflush(Journal->File) == 0;
+}
+
+
+/*FUNCTION:*/
+int Journal_Read(struct Peg_Journal *Journal, uint64_t *Delay,
+                 uint64_t *Values, int *Count)
+{
+ /*The next input & how long after the one before it was made. Returns 0 at
+   the end, Journal->Complete is then 1 when the end was whole & its key is
+   in Journal->Key, 0 when the journal was cut short or is damaged*/
+
+ unsigned char Key[8];
+ uint64_t      Number;
+ int           Value, Byte;
+
+
+ if (Journal->File == NULL || Journal->Complete) return 0;
+
+ if (!Journal_Get(Journal->File, Delay) ||
+     !Journal_Get(Journal->File, &Number))
+   return 0;
+
+ Journal->Last += *Delay;
+
+ if (Number == 0)
+ {
+  if (fread(Key, 1, 8, Journal->File) != 8) return 0;
+
+  for (Journal->Key = 0, Byte = 7; Byte >= 0; Byte--)
+     Journal->Key = Journal->Key << 8 | Key[Byte];
+
+  Journal->Complete = 1;
+  return 0;
+ }
+
+ if (Number > JOURNAL_VALUES) return 0;
+
+ for (Value = 0; Value < (int) Number; Value++)
+    if (!Journal_Get(Journal->File, &Values[Value])) return 0;
+
+ *Count = (int) Number;
+ Journal->Records++;
+ return 1;
+}
+
+
+/*FUNCTION:*/
+int Journal_Verify(struct Peg_Journal *Journal, uint64_t Key)
+{
+ /*For the end of a replay: skips what is left of the journal, closes it &
+   returns 1 when it ended whole on the board Key*/
+
+ uint64_t Delay, Values[JOURNAL_VALUES];
+ int      Count;
+
+
+ while (Journal_Read(Journal, &Delay, Values, &Count));
+
+ Journal_Close(Journal, 0);
+ return Journal->Complete && Journal->Key == Key;
+}
+
+
+/*FUNCTION:*/
+int Journal_Close(struct Peg_Journal *Journal, uint64_t Key)
+{
+ /*A journal being written gets its end with the board Key, one being read
+   is only closed. Returns 0 when the end could not be written*/
+
+ uint64_t Now;
+ int      Byte, Written = 1;
+
+
+ if (Journal->File == NULL) return 0;
+
+ if (Journal->Writing)
+ {
+  Now = Journal_Clock();
+  Journal_Put(Journal->File, Now - Journal->Last);
+  Journal_Put(Journal->File, 0);
+  for (Byte = 0; Byte < 8; Byte++)
+     putc((int) (Key >> (8 * Byte)) & 0xff, Journal->File);
+
+  Written = !ferror(Journal->File);
+ }
+
+ if (fclose(Journal->File) != 0) Written = 0;
+ Journal->File = NULL;
+ return Written;
+}
+
+
+/*FUNCTION:*/
+uint64_t Journal_Clock(void)
+{
+ /*Microseconds of the monotonic clock*/
+
+ struct timespec Now;
+
+
+ clock_gettime(CLOCK_MONOTONIC, &Now);
+ return (uint64_t) Now.tv_sec * 1000000 + Now.tv_nsec / 1000;
+}
+
+
+/*FUNCTION:*/
+void Journal_Wait(uint64_t Until)
+{
+ /*Sleeps until Journal_Clock reaches Until, for replaying at the pace of
+   the recording. Time the replay spent on the input before is not waited
+   again*/
+
+ struct timespec Time;
+ uint64_t        Now = Journal_Clock(), Delay;
+
+
+ if (Until <= Now) return;
+
+ Delay        = Until - Now;
+ Time.tv_sec  = (time_t) (Delay / 1000000);
+ Time.tv_nsec = (long) (Delay % 1000000) * 1000;
+ while (nanosleep(&Time, &Time) != 0 && errno == EINTR);
+}
+
+
+/*FUNCTION:*/
+static void Journal_Put(FILE *File, uint64_t Value)
+{
+ while (Value >= 0x80)
+ {
+  putc((int) (Value & 0x7f) | 0x80, File);
+  Value >>= 7;
+ }
+
+ putc((int) Value, File);
+}
+
+
+/*FUNCTION:*/
+static int Journal_Get(FILE *File, uint64_t *Value)
+{
+ /*0 at the end of the file or on a varint longer than 64 bits*/
+
+ int Byte, Shift;
+
+
+ *Value = 0;
+ for (Shift = 0; Shift < 64; Shift += 7)
+ {
+  if ((Byte = getc(File)) == EOF) return 0;
+
+  *Value |= (uint64_t) (Byte & 0x7f) << Shift;
+  if (!(Byte & 0x80)) return 1;
+ }
+
+ return 0;
+}
@@ -0,0 +1,88 @@
+/*Date:    17Oct2026Sat 21:20
+//File:    peg_journal.h
+//Desc:    Input journal of a session: every command token of the stdio
+           front end or every key & mouse event of the ncurses front end
+           with the time since the one before, so a session can be played
+           again exactly, at full speed or at the pace it was typed. The
+           board hash of the game at quit closes the journal, a replay that
+           does not end on the same hash went another way.
+
+           Numbers are LEB128 varints, 7 bits a byte lowest first & the top
+           bit set on every byte but the last, so a command costs 2 to 4
+           bytes. Layout of version 2:
+
+            offset size
+              0     4   magic "PEGJ"
+              4     1   version
+              5     1   kind, enum Journal_Kind
+              6         records, each:
+                  varint  microseconds since the record before (or since
+                          the journal was created)
+                  varint  n, 1 to JOURNAL_VALUES
+                  n varints the input, what it means is up to the kind
+                        then the end:
+                  varint  microseconds since the last record
+                  varint  0
+                     8    Zobrist key of the board at quit, little endian
+
+           A journal cut short (the session crashed) replays up to its last
+           whole record but has no key to check.
+
+           Version 1 is laid out the same, it was written before the count
+           command: its Command_Error token is the value Command_Count has
+           now. Journal_Open leaves the version in Journal->Version so a
+           replay can map the old tokens.
+*/
+
+
+#ifndef PEG_JOURNAL_H
+#define PEG_JOURNAL_H
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include <stdint.h>
+#include <stdio.h>
+
+#define JOURNAL_VERSION 2
+#define JOURNAL_VALUES  4 /*a key & its mouse event: y, x & buttons*/
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+/*Commands: 1 value, the enum Peg_Command of a line. Keys: the getch code,
+  for KEY_MOUSE followed by the row, column & button state of the event*/
+enum Journal_Kind {Journal_Commands, Journal_Keys};
+
+struct Peg_Journal
+{
+ FILE         *File;
+ uint64_t      Last,     /*Journal_Clock of the last record written, or
+                           when the last record read is due*/
+               Key;      /*board key of the end, once read*/
+ unsigned long Records;  /*written or read so far*/
+ int           Kind,     /*enum Journal_Kind*/
+               Version,  /*1 to JOURNAL_VERSION*/
+               Writing,
+               Complete; /*1 once the end & its key were read*/
+};
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+int      Journal_Create(struct Peg_Journal *Journal, const char *Path,
+                        int Kind);
+int      Journal_Open(struct Peg_Journal *Journal, const char *Path);
+int      Journal_Write(struct Peg_Journal *Journal, const uint64_t *Values,
+                       int Count);
+int      Journal_Read(struct Peg_Journal *Journal, uint64_t *Delay,
+                      uint64_t *Values, int *Count);
+int      Journal_Verify(struct Peg_Journal *Journal, uint64_t Key);
+int      Journal_Close(struct Peg_Journal *Journal, uint64_t Key);
+uint64_t Journal_Clock(void);
+void     Journal_Wait(uint64_t Until);
+
+#endif
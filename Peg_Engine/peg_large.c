@@ -0,0 +1,465 @@
+/*Date:    17Oct2026Sat 22:40
+//File:    peg_large.c
+//Desc:    Rules & viewport of the large cross boards of peg_large.h. The
+           shifts are written once as vector code for SSE2 (2 words a step)
+           or AVX2 (-mavx2, 4 words) & once as plain C for -DPEG_ENGINE_SCALAR
+           & other cpus, the same choice as peg_engine.c.
+*/
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include <string.h>
+#include "peg_large.h"
+
+/*Bit n of the result is bit n + 64 * Q + R of A, 0 <= R < 64. The high
+  part is shifted in 2 steps so R = 0 needs no shift by 64*/
+#define LARGE_SHIFT(A, Word, Q, R) (((A)[(Word) + (Q)] >> (R)) | \
+                                    (((A)[(Word) + (Q) + 1] << 1) << (63 - (R))))
+
+#if defined(__AVX2__) && !defined(PEG_ENGINE_SCALAR)
+#include <immintrin.h>
+#define LARGE_STEP 4
+#define VECTOR                __m256i
+#define VECTOR_LOAD(p)        _mm256_loadu_si256((const __m256i *) (p))
+#define VECTOR_STORE(p, x)    _mm256_storeu_si256((__m256i *) (p), x)
+#define VECTOR_AND(a, b)      _mm256_and_si256(a, b)
+#define VECTOR_AND_NOT(a, b)  _mm256_andnot_si256(b, a)
+#define VECTOR_OR(a, b)       _mm256_or_si256(a, b)
+#define VECTOR_RIGHT(x, n)    _mm256_srl_epi64(x, n)
+#define VECTOR_LEFT(x, n)     _mm256_sll_epi64(x, n)
+#elif defined(__SSE2__) && !defined(PEG_ENGINE_SCALAR)
+#include <emmintrin.h>
+#define LARGE_STEP 2
+#define VECTOR                __m128i
+#define VECTOR_LOAD(p)        _mm_loadu_si128((const __m128i *) (p))
+#define VECTOR_STORE(p, x)    _mm_storeu_si128((__m128i *) (p), x)
+#define VECTOR_AND(a, b)      _mm_and_si128(a, b)
+#define VECTOR_AND_NOT(a, b)  _mm_andnot_si128(b, a)
+#define VECTOR_OR(a, b)       _mm_or_si128(a, b)
+#define VECTOR_RIGHT(x, n)    _mm_srl_epi64(x, n)
+#define VECTOR_LEFT(x, n)     _mm_sll_epi64(x, n)
+#endif
+
+/*LARGE_SHIFT on LARGE_STEP words, Right & Left are the counts R & 64 - R.
+  A vector shift by 64 clears the word, so R = 0 needs nothing special*/
+#ifdef LARGE_STEP
+#define VECTOR_SHIFT(A, Word, Q, Right, Left) \
+        VECTOR_OR(VECTOR_RIGHT(VECTOR_LOAD(&(A)[(Word) + (Q)]), Right), \
+                  VECTOR_LEFT(VECTOR_LOAD(&(A)[(Word) + (Q) + 1]), Left))
+#endif
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+static void Large_Scroll(const struct Large_Geometry *Geometry,
+                         struct Large_Game *Game);
+
+
+/*--------------------
+//Function Definitions (Implementation)
+--------------------*/
+
+
+/*FUNCTION:*/
+int Large_Init(struct Large_Geometry *Geometry, int Size)
+{
+ /*Fills in the geometry of the N x N cross, Size must be odd & from
+   LARGE_MIN_SIZE to LARGE_MAX_SIZE. Returns 0 for any other size*/
+
+ const uint64_t *Valid;
+ int             Row, Col, Low, Direction, Step, Delta, Word;
+
+
+ if (Size < LARGE_MIN_SIZE || Size > LARGE_MAX_SIZE || Size % 2 == 0)
+   return 0;
+
+ memset(Geometry, 0, sizeof(*Geometry));
+ Geometry->Size   = Size;
+ Geometry->Arm    = Size / 3 % 2 ? Size / 3 : Size / 3 + 1;
+ Geometry->Stride = Size + 1;
+ Geometry->Words  = (Size * Geometry->Stride + 63) / 64;
+ Geometry->Words  = (Geometry->Words + LARGE_LANES - 1) / LARGE_LANES *
+                    LARGE_LANES;
+ Geometry->Centre = LARGE_INDEX(Geometry, Size / 2, Size / 2);
+ Geometry->View   = Size < LARGE_VIEW ? Size : LARGE_VIEW;
+
+ Low = (Size - Geometry->Arm) / 2;
+ for (Row = 0; Row < Size; Row++)
+    for (Col = 0; Col < Size; Col++)
+       if ((Row >= Low && Row < Low + Geometry->Arm) ||
+           (Col >= Low && Col < Low + Geometry->Arm))
+       {
+        Large_Flip(&Geometry->Valid, LARGE_INDEX(Geometry, Row, Col));
+        Geometry->Holes++;
+       }
+
+ Geometry->Start = Geometry->Valid;
+ Large_Flip(&Geometry->Start, Geometry->Centre);
+
+ Geometry->Offset[Jump_Up]    = -Geometry->Stride;
+ Geometry->Offset[Jump_Down]  =  Geometry->Stride;
+ Geometry->Offset[Jump_Left]  = -1;
+ Geometry->Offset[Jump_Right] =  1;
+
+ /*Delta split into whole words rounded down & the bits left over*/
+ Valid = Geometry->Valid.Word;
+ for (Direction = Jump_Up; Direction <= Jump_Right; Direction++)
+ {
+  for (Step = 0; Step < 2; Step++)
+  {
+   Delta = (Step + 1) * Geometry->Offset[Direction];
+   Geometry->Shift_Word[Direction][Step] = Delta >= 0 ? Delta / 64 :
+                                           -((63 - Delta) / 64);
+   Geometry->Shift_Bit[Direction][Step]  = Delta -
+                                       64 * Geometry->Shift_Word[Direction][Step];
+  }
+
+  for (Word = LARGE_GUARD; Word < LARGE_GUARD + Geometry->Words; Word++)
+     Geometry->Landing[Direction].Word[Word] = Valid[Word] &
+        LARGE_SHIFT(Valid, Word, Geometry->Shift_Word[Direction][1],
+                    Geometry->Shift_Bit[Direction][1]);
+ }
+
+ return 1;
+}
+
+
+/*FUNCTION:*/
+void Large_Legal_Jumps(const struct Large_Geometry *Geometry,
+                       const struct Large_Board *Pegs,
+                       struct Large_Masks *Jumps)
+{
+ /*A bead jumps in direction d when the hole Offset[d] on holds a bead & the
+   hole 2 * Offset[d] on is an empty hole of the board:
+    From[d] = Pegs & (Pegs >> Offset) & Landing[d] & ~(Pegs >> 2 * Offset)
+   with >> the shift of LARGE_SHIFT, a word at a time or a vector of them.
+   Only the guard words of Jumps are left as they were*/
+
+ const uint64_t *Bits = Pegs->Word;
+ uint64_t       *Out;
+ int             Direction, Word, Last = LARGE_GUARD + Geometry->Words,
+                 Over_Word, Over_Bit, To_Word, To_Bit;
+
+#ifdef LARGE_STEP
+ const uint64_t *Landing;
+ __m128i         Over_Right, Over_Left, To_Right, To_Left;
+ VECTOR          Over, To;
+#endif
+
+
+ for (Direction = Jump_Up; Direction <= Jump_Right; Direction++)
+ {
+  Out       = Jumps->From[Direction].Word;
+  Over_Word = Geometry->Shift_Word[Direction][0];
+  Over_Bit  = Geometry->Shift_Bit[Direction][0];
+  To_Word   = Geometry->Shift_Word[Direction][1];
+  To_Bit    = Geometry->Shift_Bit[Direction][1];
+
+#ifdef LARGE_STEP
+  Landing    = Geometry->Landing[Direction].Word;
+  Over_Right = _mm_cvtsi32_si128(Over_Bit);
+  Over_Left  = _mm_cvtsi32_si128(64 - Over_Bit);
+  To_Right   = _mm_cvtsi32_si128(To_Bit);
+  To_Left    = _mm_cvtsi32_si128(64 - To_Bit);
+
+  for (Word = LARGE_GUARD; Word < Last; Word += LARGE_STEP)
+  {
+   Over = VECTOR_SHIFT(Bits, Word, Over_Word, Over_Right, Over_Left);
+   To   = VECTOR_SHIFT(Bits, Word, To_Word, To_Right, To_Left);
+   VECTOR_STORE(&Out[Word],
+                VECTOR_AND_NOT(VECTOR_AND(VECTOR_AND(VECTOR_LOAD(&Bits[Word]),
+                                                     Over),
+                                          VECTOR_LOAD(&Landing[Word])), To));
+  }
+#else
+  for (Word = LARGE_GUARD; Word < Last; Word++)
+     Out[Word] = Bits[Word] & LARGE_SHIFT(Bits, Word, Over_Word, Over_Bit) &
+                 Geometry->Landing[Direction].Word[Word] &
+                 ~LARGE_SHIFT(Bits, Word, To_Word, To_Bit);
+#endif
+ }
+}
+
+
+/*FUNCTION:*/
+int Large_Mobility(const struct Large_Geometry *Geometry,
+                   const struct Large_Board *Pegs)
+{
+ /*Total number of legal jumps, 0 means stale mate*/
+
+ struct Large_Masks Jumps;
+ int                Direction, Word, Mobility = 0;
+
+
+ Large_Legal_Jumps(Geometry, Pegs, &Jumps);
+
+ for (Direction = Jump_Up; Direction <= Jump_Right; Direction++)
+    for (Word = LARGE_GUARD; Word < LARGE_GUARD + Geometry->Words; Word++)
+       Mobility += POPCOUNT64(Jumps.From[Direction].Word[Word]);
+
+ return Mobility;
+}
+
+
+/*FUNCTION:*/
+int Large_Jump(const struct Large_Geometry *Geometry,
+               struct Large_Board *Pegs, int From, int To)
+{
+ /*Makes the jump From -> To when it is legal & returns 1, else returns 0 &
+   leaves the board. A jump along a row that would wrap into the next row
+   always has the padding column as its over or to hole, which is never
+   valid*/
+
+ int Direction, Over;
+
+
+ if (From < 0 || To < 0 || From >= Geometry->Size * Geometry->Stride ||
+     To >= Geometry->Size * Geometry->Stride)
+   return 0;
+
+ for (Direction = Jump_Up; Direction <= Jump_Right; Direction++)
+    if (To - From == 2 * Geometry->Offset[Direction])
+      break;
+
+ if (Direction > Jump_Right) return 0;
+
+ Over = From + Geometry->Offset[Direction];
+ if (!Large_Test(Pegs, From) || !Large_Test(Pegs, Over) ||
+     Large_Test(Pegs, To) || !Large_Test(&Geometry->Valid, To))
+   return 0;
+
+ Large_Flip(Pegs, From);
+ Large_Flip(Pegs, Over);
+ Large_Flip(Pegs, To);
+ return 1;
+}
+
+
+/*FUNCTION:*/
+int Large_Count(const struct Large_Geometry *Geometry,
+                const struct Large_Board *Pegs)
+{
+ int Word, Count = 0;
+
+
+ for (Word = LARGE_GUARD; Word < LARGE_GUARD + Geometry->Words; Word++)
+    Count += POPCOUNT64(Pegs->Word[Word]);
+
+ return Count;
+}
+
+
+/*FUNCTION:*/
+int Large_Is_Won(const struct Large_Geometry *Geometry,
+                 const struct Large_Board *Pegs)
+{
+ /*1 bead left & it is on the centre*/
+
+ return Large_Count(Geometry, Pegs) == 1 &&
+        Large_Test(Pegs, Geometry->Centre);
+}
+
+
+/*FUNCTION:*/
+uint64_t Large_Hash(const struct Large_Geometry *Geometry,
+                    const struct Large_Board *Pegs)
+{
+ /*64 bit hash of the board for checking a replay, each word is mixed in
+   with a multiply & xor shift. Not a Zobrist key, the board is not hashed
+   jump by jump*/
+
+ uint64_t Hash = (uint64_t) Geometry->Size;
+ int      Word;
+
+
+ for (Word = LARGE_GUARD; Word < LARGE_GUARD + Geometry->Words; Word++)
+ {
+  Hash ^= Pegs->Word[Word];
+  Hash *= 0x9e3779b97f4a7c15ULL;
+  Hash ^= Hash >> 29;
+ }
+
+ return Hash;
+}
+
+
+/*FUNCTION:*/
+void Large_Game_Init(const struct Large_Geometry *Geometry,
+                     struct Large_Game *Game)
+{
+ /*Every hole holds a bead but the centre, the cursor starts there & the
+   viewport is centred on it*/
+
+ Game->Pegs         = Geometry->Start;
+ Game->Beads        = Geometry->Holes - 1;
+ Game->Cursor_Row   = Geometry->Size / 2;
+ Game->Cursor_Col   = Geometry->Size / 2;
+ Game->Selected_Row = LARGE_NONE;
+ Game->Selected_Col = LARGE_NONE;
+ Game->View_Row     = (Geometry->Size - Geometry->View) / 2;
+ Game->View_Col     = (Geometry->Size - Geometry->View) / 2;
+}
+
+
+/*FUNCTION:*/
+void Large_Move_Cursor(const struct Large_Geometry *Geometry,
+                       struct Large_Game *Game, int Row_Step, int Col_Step)
+{
+ /*Steps the cursor to the next hole in that direction, wrapping around
+   like Game_Move_Cursor, & scrolls the viewport after it*/
+
+ do
+ {
+  Game->Cursor_Row = (Game->Cursor_Row + Row_Step + Geometry->Size) %
+                     Geometry->Size;
+  Game->Cursor_Col = (Game->Cursor_Col + Col_Step + Geometry->Size) %
+                     Geometry->Size;
+ }
+ while (!Large_Test(&Geometry->Valid, LARGE_INDEX(Geometry, Game->Cursor_Row,
+                                                  Game->Cursor_Col)));
+
+ Large_Scroll(Geometry, Game);
+}
+
+
+/*FUNCTION:*/
+int Large_Game_Jump(const struct Large_Geometry *Geometry,
+                    struct Large_Game *Game)
+{
+ /*Jumps the selected bead to the cursor. Returns 1 & clears the selection
+   when the jump is legal, else 0*/
+
+ if (Game->Selected_Row == LARGE_NONE ||
+     !Large_Jump(Geometry, &Game->Pegs,
+                 LARGE_INDEX(Geometry, Game->Selected_Row, Game->Selected_Col),
+                 LARGE_INDEX(Geometry, Game->Cursor_Row, Game->Cursor_Col)))
+   return 0;
+
+ Game->Beads--;
+ Game->Selected_Row = LARGE_NONE;
+ Game->Selected_Col = LARGE_NONE;
+ return 1;
+}
+
+
+/*FUNCTION:*/
+void Large_Render(const struct Large_Geometry *Geometry,
+                  const struct Large_Game *Game,
+                  char Picture[LARGE_VIEW_LINES][LARGE_VIEW_WIDTH + 1])
+{
+ /*Draws the viewport in the look of Board_Picture, 4 characters & 2 lines
+   a hole: column numbers above & below, row numbers either side, [ ] round
+   the cursor & the selected bead. ^ v < > on the edges show the board goes
+   on past the viewport that way. Lines past the viewport are blank*/
+
+ const int View  = Geometry->View,
+           Right = View * 4 + 6; /*the row numbers on the right*/
+ int       Line, Row, Col, Board_Row, Board_Col, Above, Below, X;
+
+
+ for (Line = 0; Line < LARGE_VIEW_LINES; Line++)
+ {
+  memset(Picture[Line], ' ', LARGE_VIEW_WIDTH);
+  Picture[Line][LARGE_VIEW_WIDTH] = '\0';
+ }
+
+ for (Col = 0; Col < View; Col++)
+ {
+  Board_Col = Game->View_Col + Col;
+  X         = Col * 4 + 6;
+
+  Picture[0][X - 1] = Picture[2 * View + 2][X - 1] =
+                      Board_Col >= 10 ? '0' + Board_Col / 10 : ' ';
+  Picture[0][X]     = Picture[2 * View + 2][X] = '0' + Board_Col % 10;
+ }
+
+ for (Row = 0; Row <= View; Row++)
+ {
+  Board_Row = Game->View_Row + Row;
+  Line      = 2 * Row + 1;
+
+  /*The border above the row, under every hole of the row before or this*/
+  for (Col = 0; Col < View; Col++)
+  {
+   Board_Col = Game->View_Col + Col;
+   Above     = Row > 0 &&
+               Large_Test(&Geometry->Valid,
+                          LARGE_INDEX(Geometry, Board_Row - 1, Board_Col));
+   Below     = Row < View &&
+               Large_Test(&Geometry->Valid,
+                          LARGE_INDEX(Geometry, Board_Row, Board_Col));
+
+   if (Above || Below)
+   {
+    X = Col * 4 + 4;
+    memcpy(&Picture[Line][X], "+---+", 5);
+   }
+  }
+
+  if (Row == View) break;
+
+  Line++;
+  Picture[Line][1]  = Board_Row >= 10 ? '0' + Board_Row / 10 : ' ';
+  Picture[Line][2]  = '0' + Board_Row % 10;
+  Picture[Line][Right]     = Picture[Line][1];
+  Picture[Line][Right + 1] = Picture[Line][2];
+
+  for (Col = 0; Col < View; Col++)
+  {
+   Board_Col = Game->View_Col + Col;
+   if (!Large_Test(&Geometry->Valid,
+                   LARGE_INDEX(Geometry, Board_Row, Board_Col)))
+     continue;
+
+   X = Col * 4 + 6;
+   Picture[Line][X - 2] = Picture[Line][X + 2] = '|';
+   Picture[Line][X]     = Large_Test(&Game->Pegs,
+                                     LARGE_INDEX(Geometry, Board_Row,
+                                                 Board_Col)) ? 'X' : ' ';
+
+   if ((Board_Row == Game->Cursor_Row && Board_Col == Game->Cursor_Col) ||
+       (Board_Row == Game->Selected_Row && Board_Col == Game->Selected_Col))
+   {
+    Picture[Line][X - 1] = '[';
+    Picture[Line][X + 1] = ']';
+   }
+  }
+ }
+
+ /*Scroll marks*/
+ Line = View / 2 * 2 + 2; /*the middle row*/
+ if (Game->View_Row > 0)                       Picture[0][2]            = '^';
+ if (Game->View_Row + View < Geometry->Size)   Picture[2 * View + 2][2] = 'v';
+ if (Game->View_Col > 0)                       Picture[Line][0]         = '<';
+ if (Game->View_Col + View < Geometry->Size)   Picture[Line][Right - 1] = '>';
+}
+
+
+/*FUNCTION:*/
+static void Large_Scroll(const struct Large_Geometry *Geometry,
+                         struct Large_Game *Game)
+{
+ /*Keeps 1 hole between the cursor & the edge of the viewport wherever the
+   board goes on past it*/
+
+ const int View = Geometry->View,
+           Last = Geometry->Size - Geometry->View;
+
+
+ if (Game->Cursor_Row < Game->View_Row + 1)
+   Game->View_Row = Game->Cursor_Row - 1;
+ if (Game->Cursor_Row > Game->View_Row + View - 2)
+   Game->View_Row = Game->Cursor_Row - View + 2;
+ if (Game->Cursor_Col < Game->View_Col + 1)
+   Game->View_Col = Game->Cursor_Col - 1;
+ if (Game->Cursor_Col > Game->View_Col + View - 2)
+   Game->View_Col = Game->Cursor_Col - View + 2;
+
+ if (Game->View_Row < 0)    Game->View_Row = 0;
+ if (Game->View_Row > Last) Game->View_Row = Last;
+ if (Game->View_Col < 0)    Game->View_Col = 0;
+ if (Game->View_Col > Last) Game->View_Col = Last;
+}
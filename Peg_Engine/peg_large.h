@@ -0,0 +1,147 @@
+/*Date:    17Oct2026Sat 22:40
+//File:    peg_large.h
+//Desc:    Cross boards of any odd size N from LARGE_MIN_SIZE to LARGE_MAX_SIZE
+           (15x15 has 125 holes, 33x33 has 605), too big for the 2 words of
+           struct Bitboard. The size is picked at run time, so everything the
+           9x9 engine keeps in constants lives in struct Large_Geometry.
+
+           The bit layout is that of peg_engine.h with a stride of N + 1:
+           index = row * Stride + col & column N of every row is padding, so
+           a 9x9 large board numbers its holes like the 9x9 engine. The arms
+           are N / 3 holes wide, made odd so the board has a centre, e.g.
+
+            N  7: 3 wide (the English board)  N 15: 5 wide
+            N  9: 3 wide (the cross)          N 21: 7 wide
+
+           A board is an array of 64 bit words with LARGE_GUARD words of 0 on
+           either side of the bits in use: a shift by any jump distance reads
+           the word it needs & the 1 next to it without a test at the ends,
+           so every word of the result is the same 4 loads, 2 shifts & an OR.
+           With SSE2 or AVX2 (-mavx2) that runs on 2 or 4 words at a time,
+           Words is rounded up to a multiple of LARGE_LANES so there is no
+           tail to finish in scalar code.
+
+           Only play is covered: legal jumps, mobility, jumping, the win test
+           & a viewport that draws a window of at most LARGE_VIEW holes a
+           side, scrolling with the cursor. The solver, the database, saves &
+           undo are for the boards of peg_geometry.h.
+*/
+
+
+#ifndef PEG_LARGE_H
+#define PEG_LARGE_H
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include "peg_engine.h"
+
+#define LARGE_MIN_SIZE    7
+#define LARGE_MAX_SIZE   33
+#define LARGE_GUARD       2  /*words of 0 either side, jumps reach 2 * 34 bits*/
+#define LARGE_LANES       4  /*words of an AVX2 register*/
+#define LARGE_WORDS      24  /*2 guards + 1122 bits of 33 x 34 rounded to 20*/
+#define LARGE_NONE       -1  /*Selected_Row & Selected_Col, nothing selected*/
+
+#define LARGE_VIEW        9  /*holes a side drawn at most*/
+#define LARGE_VIEW_LINES 21  /*of a Large_Render picture*/
+#define LARGE_VIEW_WIDTH 44
+
+#define LARGE_INDEX(Geometry, Row, Col) ((Row) * (Geometry)->Stride + (Col))
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+/*Bit n in Word[LARGE_GUARD + n / 64], the guard words stay 0*/
+struct Large_Board
+{
+ uint64_t Word[LARGE_WORDS];
+};
+
+struct Large_Geometry
+{
+ int                Size,        /*N, holes a side*/
+                    Arm,         /*width of an arm*/
+                    Stride,      /*N + 1*/
+                    Words,       /*in use after the guard, multiple of
+                                   LARGE_LANES*/
+                    Holes,
+                    Centre,      /*index of the start & finish hole*/
+                    View,        /*holes a side of the viewport*/
+                    Offset[4],   /*of the bead jumped over, enum
+                                   Jump_Direction*/
+                    Shift_Word[4][2], /*a shift by Offset[d] (0) & by 2 *
+                                        Offset[d] (1) as whole words &*/
+                    Shift_Bit[4][2];  /*bits, see Large_Legal_Jumps*/
+ struct Large_Board Valid,
+                    Start,
+                    Landing[4];  /*holes 2 * Offset[d] on from a valid hole*/
+};
+
+/*Bit n of From[d] is set when the bead on hole n can jump in direction d*/
+struct Large_Masks
+{
+ struct Large_Board From[4];
+};
+
+/*1 game on a large board, the viewport shows holes View_Row to View_Row +
+  View - 1 & the same for columns*/
+struct Large_Game
+{
+ struct Large_Board Pegs;
+ int                Beads,
+                    Cursor_Row,
+                    Cursor_Col,
+                    Selected_Row, /*LARGE_NONE when no bead is selected*/
+                    Selected_Col,
+                    View_Row,
+                    View_Col;
+};
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+int      Large_Init(struct Large_Geometry *Geometry, int Size);
+void     Large_Legal_Jumps(const struct Large_Geometry *Geometry,
+                           const struct Large_Board *Pegs,
+                           struct Large_Masks *Jumps);
+int      Large_Mobility(const struct Large_Geometry *Geometry,
+                        const struct Large_Board *Pegs);
+int      Large_Jump(const struct Large_Geometry *Geometry,
+                    struct Large_Board *Pegs, int From, int To);
+int      Large_Count(const struct Large_Geometry *Geometry,
+                     const struct Large_Board *Pegs);
+int      Large_Is_Won(const struct Large_Geometry *Geometry,
+                      const struct Large_Board *Pegs);
+uint64_t Large_Hash(const struct Large_Geometry *Geometry,
+                    const struct Large_Board *Pegs);
+void     Large_Game_Init(const struct Large_Geometry *Geometry,
+                         struct Large_Game *Game);
+void     Large_Move_Cursor(const struct Large_Geometry *Geometry,
+                           struct Large_Game *Game, int Row_Step,
+                           int Col_Step);
+int      Large_Game_Jump(const struct Large_Geometry *Geometry,
+                         struct Large_Game *Game);
+void     Large_Render(const struct Large_Geometry *Geometry,
+                      const struct Large_Game *Game,
+                      char Picture[LARGE_VIEW_LINES][LARGE_VIEW_WIDTH + 1]);
+
+
+/*--------------------
+//Inline Definitions (the hot bit operations)
+--------------------*/
+static inline int Large_Test(const struct Large_Board *Board, int Index)
+{
+ return (int) ((Board->Word[LARGE_GUARD + Index / 64] >> (Index % 64)) & 1);
+}
+
+
+static inline void Large_Flip(struct Large_Board *Board, int Index)
+{
+ Board->Word[LARGE_GUARD + Index / 64] ^= (uint64_t) 1 << (Index % 64);
+}
+
+#endif
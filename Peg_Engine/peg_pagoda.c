@@ -0,0 +1,258 @@
+/*Date:    17Oct2026Sat 19:40
+//File:    peg_pagoda.c
+//Desc:    Pagoda & position class tables of peg_pagoda.h. The weights were
+           found by linear programming: for sampled lost positions of the
+           solver, a weighting with the least sum under the beads subject to
+           the 108 jump constraints & w(board[4][4]) = 1, scaled to whole
+           numbers. Of the candidates & their 8 rotations / reflections the
+           PAGODA_COUNT that together proved the most samples lost were kept.
+*/
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include "peg_pagoda.h"
+
+
+/*----------------------------
+//Global Variable Declarations
+----------------------------*/
+uint64_t Pagoda_Delta[JUMP_DIRECTIONS][BOARD_BITS][PAGODA_WORDS];
+uint64_t Pagoda_Floor[BOARD_HOLES + 1][PAGODA_WORDS];
+uint64_t Pagoda_Bias[BOARD_HOLES + 1][PAGODA_WORDS];
+
+/*Weights by row & column, 0 off the cross. Each one satisfies
+  w(from) + w(over) >= w(to) for all 108 jumps of the cross & so for the 76
+  of the English board*/
+#if PEG_GEOMETRY == GEOMETRY_CROSS || PEG_GEOMETRY == GEOMETRY_ENGLISH
+static const signed char Pagoda_Weight[PAGODA_COUNT][BOARD_SIZE][BOARD_SIZE] =
+{
+ {
+  {  0,  0,  0, -6,  0, -6,  0,  0,  0},
+  {  0,  0,  0,  6,  1,  6,  0,  0,  0},
+  {  0,  0,  0,  0,  1,  0,  0,  0,  0},
+  { -6,  6,  0,  6,  2,  6,  0,  6, -6},
+  {  0,  3,  3,  0,  3,  3,  0,  3,  0},
+  { -6,  6,  0,  6,  0,  6,  0,  6, -6},
+  {  0,  0,  0,  0,  3,  0,  0,  0,  0},
+  {  0,  0,  0,  6,  3,  6,  0,  0,  0},
+  {  0,  0,  0, -6,  0, -6,  0,  0,  0}
+ },
+ {
+  {  0,  0,  0, -6,  0, -6,  0,  0,  0},
+  {  0,  0,  0,  6,  3,  6,  0,  0,  0},
+  {  0,  0,  0,  0,  3,  0,  0,  0,  0},
+  { -6,  6,  0,  6,  0,  6,  0,  6, -6},
+  {  0,  1,  1,  2,  3,  0,  3,  3,  0},
+  { -6,  6,  0,  6,  3,  6,  0,  6, -6},
+  {  0,  0,  0,  0,  0,  0,  0,  0,  0},
+  {  0,  0,  0,  6,  3,  6,  0,  0,  0},
+  {  0,  0,  0, -6,  0, -6,  0,  0,  0}
+ },
+ {
+  {  0,  0,  0,-12,  0,-12,  0,  0,  0},
+  {  0,  0,  0, 12,  9, 12,  0,  0,  0},
+  {  0,  0,  0,  0,  0,  0,  0,  0,  0},
+  {-12, 12,  0, 12,  9, 12,  0, 12,-12},
+  {  0,  2,  2,  4,  6,  4,  2,  2,  0},
+  {-12, 12,  0, 12,  3, 12,  0, 12,-12},
+  {  0,  0,  0,  0,  3,  0,  0,  0,  0},
+  {  0,  0,  0, 12,  0, 12,  0,  0,  0},
+  {  0,  0,  0,-12,  3, -9,  0,  0,  0}
+ },
+ {
+  {  0,  0,  0, -6,  0, -6,  0,  0,  0},
+  {  0,  0,  0,  6,  1,  6,  0,  0,  0},
+  {  0,  0,  0,  0,  1,  0,  0,  0,  0},
+  { -6,  6,  0,  6,  2,  6,  0,  6, -6},
+  {  0,  1,  1,  2,  3,  5,  8,  0,  8},
+  { -6,  6,  0,  6,  5,  6,  0,  6, -6},
+  {  0,  0,  0,  0,  0,  0,  0,  0,  0},
+  {  0,  0,  0,  6,  5,  6,  0,  0,  0},
+  {  0,  0,  0, -6,  0, -6,  0,  0,  0}
+ },
+ {
+  {  0,  0,  0,  0,  0,  0,  0,  0,  0},
+  {  0,  0,  0,  0,  1,  0,  0,  0,  0},
+  {  0,  0,  0,  0,  1,  0,  0,  0,  0},
+  {  0,  0,  0,  0,  0,  0,  0,  0,  0},
+  {  0,  1,  1,  0,  1,  0,  1,  0,  1},
+  {  0,  0,  0,  0,  0,  0,  0,  0,  0},
+  {  0,  0,  0,  0,  1,  0,  0,  0,  0},
+  {  0,  0,  0,  0,  0,  0,  0,  0,  0},
+  {  0,  0,  0,  0,  1,  0,  0,  0,  0}
+ },
+ {
+  {  0,  0,  0,  0,  1,  0,  0,  0,  0},
+  {  0,  0,  0,  0,  0,  0,  0,  0,  0},
+  {  0,  0,  0,  0,  1,  0,  0,  0,  0},
+  {  0,  0,  0,  0,  0,  0,  0,  0,  0},
+  {  1,  0,  1,  0,  1,  0,  1,  1,  0},
+  {  0,  0,  0,  0,  0,  0,  0,  0,  0},
+  {  0,  0,  0,  0,  1,  0,  0,  0,  0},
+  {  0,  0,  0,  0,  1,  0,  0,  0,  0},
+  {  0,  0,  0,  0,  0,  0,  0,  0,  0}
+ },
+ {
+  {  0,  0,  0, -6,  0, -6,  0,  0,  0},
+  {  0,  0,  0,  6,  1,  6,  0,  0,  0},
+  {  0,  0,  0,  0,  1,  0,  0,  0,  0},
+  { -6,  6,  0,  6,  2,  6,  0,  6, -6},
+  {  3,  0,  3,  0,  3,  3,  0,  3,  0},
+  { -6,  6,  0,  6,  5,  6,  0,  6, -6},
+  {  0,  0,  0,  0,  0,  0,  0,  0,  0},
+  {  0,  0,  0,  6,  5,  6,  0,  0,  0},
+  {  0,  0,  0, -6,  0, -6,  0,  0,  0}
+ },
+ {
+  {  0,  0,  0,-12,  0,-12,  0,  0,  0},
+  {  0,  0,  0, 12,  2, 12,  0,  0,  0},
+  {  0,  0,  0,  0,  2,  0,  0,  0,  0},
+  {-12, 12,  0, 12,  4, 12,  0, 12,-12},
+  {  0,  9,  0,  9,  6,  3,  3,  0,  3},
+  {-12, 12,  0, 12,  4, 12,  0, 12, -9},
+  {  0,  0,  0,  0,  2,  0,  0,  0,  0},
+  {  0,  0,  0, 12,  2, 12,  0,  0,  0},
+  {  0,  0,  0,-12,  0,-12,  0,  0,  0}
+ }
+};
+#else
+static const signed char Pagoda_Weight[PAGODA_COUNT][BOARD_SIZE][BOARD_SIZE] =
+                         {{{0}}};
+#endif
+
+static uint64_t        Hole_Value[BOARD_BITS][PAGODA_WORDS]; /*biased, packed*/
+static struct Bitboard Colour[2][3]; /*holes by (row + col) % 3, (row - col) % 3*/
+static int             Finish_Class;
+static int             Pagoda_Ready = 0;
+
+
+/*--------------------
+//Function Definitions (Implementation)
+--------------------*/
+
+
+/*FUNCTION:*/
+void Pagoda_Init(void)
+{
+ /*Packs the weights of every hole, the jump deltas, the floors & the class of
+   the finish, calling it again does nothing*/
+
+ const struct Jump *Jump;
+ int                Row, Col, Hole, Pagoda, Direction, Beads, Word, Weight;
+
+
+ if (Pagoda_Ready) return;
+
+ for (Row = 0; Row < BOARD_SIZE; Row++)
+    for (Col = 0; Col < BOARD_SIZE; Col++)
+    {
+     Hole = HOLE_INDEX(Row, Col);
+     if (!Bitboard_Test(Valid_Holes, Hole)) continue;
+
+     for (Pagoda = 0; Pagoda < PAGODA_COUNT; Pagoda++)
+        Hole_Value[Hole][Pagoda / PAGODA_LANES] |=
+                   (uint64_t) (Pagoda_Weight[Pagoda][Row][Col] + PAGODA_BIAS) <<
+                   (16 * (Pagoda % PAGODA_LANES));
+
+     Colour[0][(Row + Col) % 3] =
+                      Bitboard_Or(Colour[0][(Row + Col) % 3], Bitboard_Bit(Hole));
+#if JUMP_DIRECTIONS == 6
+     Colour[1][(Row + Col) % 3] =
+                      Bitboard_Or(Colour[1][(Row + Col) % 3], Bitboard_Bit(Hole));
+#else
+     Colour[1][(Row - Col + BOARD_SIZE) % 3] =
+       Bitboard_Or(Colour[1][(Row - Col + BOARD_SIZE) % 3], Bitboard_Bit(Hole));
+#endif
+    }
+
+ /*Unsigned wrap around: a lane going down borrows from the lane above it in
+   the delta, the same borrow comes back when the delta is added to sums that
+   hold the from & over weights*/
+ for (Jump = Jump_Table; Jump < Jump_Table + JUMP_COUNT; Jump++)
+ {
+  for (Direction = Jump_Up;
+       Jump->From + 2 * Jump_Offset[Direction] != Jump->To; Direction++);
+
+  for (Word = 0; Word < PAGODA_WORDS; Word++)
+     Pagoda_Delta[Direction][Jump->From][Word] = Hole_Value[Jump->To][Word] -
+                                                 Hole_Value[Jump->From][Word] -
+                                                 Hole_Value[Jump->Over][Word];
+ }
+
+ /*The finish holds w(finish) + 1 bias, every bead more at least 1 bias*/
+ for (Beads = 1; Beads <= BOARD_HOLES; Beads++)
+    for (Pagoda = 0; Pagoda < PAGODA_COUNT; Pagoda++)
+    {
+     Weight = Pagoda_Weight[Pagoda][BOARD_CENTRE / BOARD_STRIDE]
+                                   [BOARD_CENTRE % BOARD_STRIDE];
+     Pagoda_Floor[Beads][Pagoda / PAGODA_LANES] |=
+                          (uint64_t) (Weight + PAGODA_BIAS * Beads) <<
+                          (16 * (Pagoda % PAGODA_LANES));
+     Pagoda_Bias[Beads][Pagoda / PAGODA_LANES] |=
+                      (uint64_t) (PAGODA_BIAS * Beads) <<
+                      (16 * (Pagoda % PAGODA_LANES));
+    }
+
+ Finish_Class = Position_Class(Bitboard_Bit(BOARD_CENTRE));
+ Pagoda_Ready = 1;
+}
+
+
+/*FUNCTION:*/
+struct Pagoda_Sums Pagoda_Evaluate(struct Bitboard Pegs)
+{
+ /*The sums from scratch, for the board a search starts from*/
+
+ struct Pagoda_Sums Sums;
+ int                Hole, Word;
+
+
+ Pegs = Bitboard_And(Pegs, Valid_Holes);
+
+ for (Word = 0; Word < PAGODA_WORDS; Word++)
+    Sums.Word[Word] = 0;
+
+ while (!Bitboard_Is_Empty(Pegs))
+ {
+  Hole = Bitboard_Pop(&Pegs);
+
+  for (Word = 0; Word < PAGODA_WORDS; Word++)
+     Sums.Word[Word] += Hole_Value[Hole][Word];
+ }
+
+ return Sums;
+}
+
+
+/*FUNCTION:*/
+int Position_Class(struct Bitboard Pegs)
+{
+ /*The 4 invariant parities: bit 0 & 1 for (row + col) % 3, bit 2 & 3 for
+   (row - col) % 3, 16 classes in all*/
+
+ int Colouring, Count[3], Class = 0;
+
+
+ for (Colouring = 0; Colouring < 2; Colouring++)
+ {
+  Count[0] = Bitboard_Count(Bitboard_And(Pegs, Colour[Colouring][0]));
+  Count[1] = Bitboard_Count(Bitboard_And(Pegs, Colour[Colouring][1]));
+  Count[2] = Bitboard_Count(Bitboard_And(Pegs, Colour[Colouring][2]));
+
+  Class |= (((Count[0] + Count[1]) & 1) | ((Count[1] + Count[2]) & 1) << 1) <<
+           (2 * Colouring);
+ }
+
+ return Class;
+}
+
+
+/*FUNCTION:*/
+int Position_Class_Lost(struct Bitboard Pegs)
+{
+ /*1 when Pegs is not in the class of 1 bead on the finish*/
+
+ return Position_Class(Pegs) != Finish_Class;
+}
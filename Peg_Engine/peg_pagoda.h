@@ -0,0 +1,155 @@
+/*Date:    17Oct2026Sat 19:40
+//File:    peg_pagoda.h
+//Desc:    Proofs in O(1) that a position can never finish with 1 bead on
+           board[4][4], for cutting the solver's search.
+
+           Pagoda functions (Conway's resource counts): every hole h gets a
+           weight w(h) such that w(from) + w(over) >= w(to) for each of the
+           108 jumps. A jump then never raises the sum of the weights under
+           the beads, so a position whose sum is already below w(board[4][4])
+           is lost. A jump changes the sum by w(to) - w(from) - w(over), so the
+           solver carries the sums down the search & updates them with 1
+           table add per jump instead of summing the board again.
+
+           The PAGODA_COUNT sums are packed 4 to a 64 bit word, 16 bits each,
+           with PAGODA_BIAS added to every weight so no lane ever goes below 0
+           & 1 word add updates 4 pagodas; 1 subtract & mask tests them.
+
+           Position classes: colour the holes by (row + col) % 3 & again by
+           (row - col) % 3. The 3 holes of a jump have 3 different colours in
+           both colourings, so each jump flips the parity of all 6 colour
+           counts & the parities of count 0 + count 1 & count 1 + count 2 of
+           each colouring never change. A board whose 4 parities differ from
+           those of the finish is lost however it is played; as no jump
+           changes them this is tested once, on the board searched from.
+
+           Other boards of peg_geometry.h: the English holes & jumps are a
+           part of the cross's with the same finish, so the cross pagodas
+           hold there unchanged. No pagoda is fitted to the European board &
+           the triangle, they get 1 of all 0 weights that cuts nothing. On
+           the triangle the diagonal jumps keep row - col, only the (row +
+           col) % 3 colouring tells their holes apart & it stands in for both.
+
+           Pagoda_Init must run once before the other functions, it is not
+           thread safe; after it every function is.
+*/
+
+
+#ifndef PEG_PAGODA_H
+#define PEG_PAGODA_H
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include "peg_engine.h"
+
+#if PEG_GEOMETRY == GEOMETRY_CROSS || PEG_GEOMETRY == GEOMETRY_ENGLISH
+#define PAGODA_COUNT 8
+#else
+#define PAGODA_COUNT 1
+#endif
+#define PAGODA_LANES 4  /*16 bit sums in a 64 bit word*/
+#define PAGODA_WORDS ((PAGODA_COUNT + PAGODA_LANES - 1) / PAGODA_LANES)
+#define PAGODA_BIAS  16 /*added to every weight, keeps the lanes >= 0*/
+#define PAGODA_SIGN  0x8000800080008000ULL /*top bit of every lane*/
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+/*Biased weight sums of the beads, pagoda n in lane n % 4 of Word[n / 4]*/
+struct Pagoda_Sums
+{
+ uint64_t Word[PAGODA_WORDS];
+};
+
+
+/*----------------------------
+//Global Variable Declarations
+----------------------------*/
+/*Change of the sums by the jump from hole n in direction d, the lowest sums
+  a board of k beads may have to still reach the finish & the bias of k
+  beads. Filled by Pagoda_Init*/
+extern uint64_t Pagoda_Delta[JUMP_DIRECTIONS][BOARD_BITS][PAGODA_WORDS];
+extern uint64_t Pagoda_Floor[BOARD_HOLES + 1][PAGODA_WORDS];
+extern uint64_t Pagoda_Bias[BOARD_HOLES + 1][PAGODA_WORDS];
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+void               Pagoda_Init(void);
+struct Pagoda_Sums Pagoda_Evaluate(struct Bitboard Pegs);
+int                Position_Class(struct Bitboard Pegs);
+int                Position_Class_Lost(struct Bitboard Pegs);
+
+
+/*--------------------
+//Inline Definitions (the per node operations of the solver)
+--------------------*/
+/*The sums after the jump from hole From in Direction*/
+static inline struct Pagoda_Sums Pagoda_Jump(struct Pagoda_Sums Sums, int From,
+                                             int Direction)
+{
+ int Word;
+
+
+ for (Word = 0; Word < PAGODA_WORDS; Word++)
+    Sums.Word[Word] += Pagoda_Delta[Direction][From][Word];
+
+ return Sums;
+}
+
+
+/*The sums before the jump from hole From in Direction, for searching
+  backwards*/
+static inline struct Pagoda_Sums Pagoda_Unjump(struct Pagoda_Sums Sums,
+                                               int From, int Direction)
+{
+ int Word;
+
+
+ for (Word = 0; Word < PAGODA_WORDS; Word++)
+    Sums.Word[Word] -= Pagoda_Delta[Direction][From][Word];
+
+ return Sums;
+}
+
+
+/*1 when a sum of the board of Beads beads is below its floor. Setting the top
+  bit of every lane before the subtract keeps a borrow inside its lane, the
+  bit survives exactly in the lanes at or above the floor*/
+static inline int Pagoda_Lost(struct Pagoda_Sums Sums, int Beads)
+{
+ uint64_t Above = PAGODA_SIGN;
+ int      Word;
+
+
+ for (Word = 0; Word < PAGODA_WORDS; Word++)
+    Above &= (Sums.Word[Word] | PAGODA_SIGN) - Pagoda_Floor[Beads][Word];
+
+ return Above != PAGODA_SIGN;
+}
+
+
+
+/*0 when a board of Beads beads with Sums cannot be reached from the board of
+  Start_Beads beads with Start: jumps never raise a sum, so no sum may be
+  above that of Start. The bias of the beads Sums lacks is added first so
+  both sides carry the same bias*/
+static inline int Pagoda_Reachable(struct Pagoda_Sums Sums, int Beads,
+                                   struct Pagoda_Sums Start, int Start_Beads)
+{
+ uint64_t Below = PAGODA_SIGN;
+ int      Word;
+
+
+ for (Word = 0; Word < PAGODA_WORDS; Word++)
+    Below &= (Start.Word[Word] | PAGODA_SIGN) -
+             (Sums.Word[Word] + Pagoda_Bias[Start_Beads - Beads][Word]);
+
+ return Below == PAGODA_SIGN;
+}
+
+#endif
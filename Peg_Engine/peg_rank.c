@@ -0,0 +1,114 @@
+/*Date:    17Oct2026Sat 19:05
+//File:    peg_rank.c
+//Desc:    Combinadic rank & unrank of peg_rank.h. Both walk the beads with
+           count trailing zeros & look every term up in 1 table of binomial
+           coefficients; with -mbmi2 the board to packed form step under
+           Rank_Pegs & Unrank_Pegs is a single pext / pdep (see peg_engine.c).
+*/
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include "peg_rank.h"
+
+#define RANK_ALL_HOLES (((uint64_t) 1 << BOARD_HOLES) - 1)
+
+
+/*----------------------------
+//Global Variable Declarations
+----------------------------*/
+static uint64_t Binomial[BOARD_HOLES + 1][RANK_HALF + 1]; /*C(n, k), k <= 22*/
+static int      Rank_Ready = 0;
+
+
+/*--------------------
+//Function Definitions (Implementation)
+--------------------*/
+
+
+/*FUNCTION:*/
+void Rank_Init(void)
+{
+ /*Pascal's triangle up to C(45, 22), calling it again does nothing*/
+
+ int Row, Col;
+
+
+ if (Rank_Ready) return;
+
+ for (Row = 0; Row <= BOARD_HOLES; Row++)
+    for (Col = 0; Col <= RANK_HALF; Col++)
+       Binomial[Row][Col] = Col == 0 ? 1
+                          : Row == 0 ? 0
+                          : Binomial[Row - 1][Col - 1] + Binomial[Row - 1][Col];
+
+ Rank_Ready = 1;
+}
+
+
+/*FUNCTION:*/
+uint64_t Rank_Count(int Pegs)
+{
+ /*Boards of Pegs beads, C(45, Pegs)*/
+
+ if (Pegs < 0 || Pegs > BOARD_HOLES) return 0;
+ return Binomial[BOARD_HOLES][Pegs > RANK_HALF ? BOARD_HOLES - Pegs : Pegs];
+}
+
+
+/*FUNCTION:*/
+uint64_t Rank_Packed(uint64_t Packed)
+{
+ /*Rank of the packed board among the boards with as many beads*/
+
+ uint64_t Rank  = 0;
+ int      Index = 1;
+
+
+ if (POPCOUNT64(Packed) > RANK_HALF)
+   Packed ^= RANK_ALL_HOLES;
+
+ for (; Packed; Packed &= Packed - 1)
+   Rank += Binomial[CTZ64(Packed)][Index++];
+
+ return Rank;
+}
+
+
+/*FUNCTION:*/
+uint64_t Unrank_Packed(int Pegs, uint64_t Rank)
+{
+ /*The packed board of Pegs beads with that rank, highest bead first: each
+   bead goes on the highest hole whose binomial still fits in the rank*/
+
+ uint64_t Packed   = 0;
+ int      Position = BOARD_HOLES,
+          Count    = Pegs > RANK_HALF ? BOARD_HOLES - Pegs : Pegs;
+
+
+ for (; Count > 0; Count--)
+ {
+  do Position--;
+  while (Binomial[Position][Count] > Rank);
+
+  Packed |= (uint64_t) 1 << Position;
+  Rank   -= Binomial[Position][Count];
+ }
+
+ return Pegs > RANK_HALF ? Packed ^ RANK_ALL_HOLES : Packed;
+}
+
+
+/*FUNCTION:*/
+uint64_t Rank_Pegs(struct Bitboard Pegs)
+{
+ return Rank_Packed(Bitboard_Pack(Pegs));
+}
+
+
+/*FUNCTION:*/
+struct Bitboard Unrank_Pegs(int Pegs, uint64_t Rank)
+{
+ return Bitboard_Unpack(Unrank_Packed(Pegs, Rank));
+}
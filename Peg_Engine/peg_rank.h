@@ -0,0 +1,44 @@
+/*Date:    17Oct2026Sat 19:05
+//File:    peg_rank.h
+//Desc:    Dense numbering of the boards with a given number of beads. The
+           C(45, k) boards of k beads get the ranks 0 to C(45, k) - 1, so a
+           table about boards of k beads can be a flat array or bitset
+           indexed by rank instead of a hash table: no keys, no pointers &
+           neighbouring ranks are neighbouring bytes.
+
+           The rank is the combinadic number of the 45 bit packed board (see
+           Bitboard_Pack): beads on packed holes p1 < p2 < ... < pk give
+           C(p1, 1) + C(p2, 2) + ... + C(pk, k), which numbers the boards of
+           k beads in increasing order of their packed value. Boards of more
+           than RANK_HALF beads are numbered by their empty holes instead
+           (C(45, k) = C(45, 45 - k)), so rank & unrank never walk more than
+           22 bits; those ranks run in decreasing packed order.
+
+           Rank_Init must run once before the other functions, it is not
+           thread safe; after it every function is.
+*/
+
+
+#ifndef PEG_RANK_H
+#define PEG_RANK_H
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include "peg_engine.h"
+
+#define RANK_HALF (BOARD_HOLES / 2) /*22, above it the empty holes count*/
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+void            Rank_Init(void);
+uint64_t        Rank_Count(int Pegs);
+uint64_t        Rank_Packed(uint64_t Packed);
+uint64_t        Unrank_Packed(int Pegs, uint64_t Rank);
+uint64_t        Rank_Pegs(struct Bitboard Pegs);
+struct Bitboard Unrank_Pegs(int Pegs, uint64_t Rank);
+
+#endif
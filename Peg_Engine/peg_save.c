@@ -0,0 +1,251 @@
+/*Date:    17Oct2026Sat 13:10
+//File:    peg_save.c
+//Desc:    Reads & writes the save file described in peg_save.h. A file is
+           only accepted when every field checks out: magic, version, size,
+           CRC, the board of the build, cursor & selection on valid holes & a
+           move log that can be played back & forth from the saved board.
+*/
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include <stdio.h>
+#include <string.h>
+#include "peg_save.h"
+
+#define SAVE_FLAG_LOG      1
+#define SAVE_FLAG_GEOMETRY 6                   /*bits of the PEG_GEOMETRY*/
+#define SAVE_GEOMETRY      (PEG_GEOMETRY << 1) /*0 on the cross*/
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+static int Save_Check_Log(const struct Peg_Game *Game);
+
+
+/*--------------------
+//Function Definitions (Implementation)
+--------------------*/
+
+
+/*FUNCTION:*/
+size_t Save_Encode(const struct Peg_Game *Game, unsigned char *Bytes)
+{
+ /*Writes Game to Bytes (room for SAVE_MAX_BYTES) & returns the length*/
+
+ uint64_t Packed = Bitboard_Pack(Game->Pegs);
+ uint32_t Crc;
+ size_t   Length = 20;
+ int      Move, Byte;
+
+
+ memcpy(Bytes, "PEGS", 4);
+ Bytes[4] = SAVE_VERSION;
+ Bytes[5] = (Game->Moves_Logged > 0 ? SAVE_FLAG_LOG : 0) | SAVE_GEOMETRY;
+
+ for (Byte = 0; Byte < 8; Byte++)
+    Bytes[6 + Byte] = (unsigned char) (Packed >> (8 * Byte));
+
+ Bytes[14] = (unsigned char) Game->Cursor_Row;
+ Bytes[15] = (unsigned char) Game->Cursor_Col;
+ Bytes[16] = (unsigned char) Game->Selected_Row;
+ Bytes[17] = (unsigned char) Game->Selected_Col;
+ Bytes[18] = (unsigned char) Game->Moves_Made;
+ Bytes[19] = (unsigned char) Game->Moves_Logged;
+
+ for (Move = 0; Move < Game->Moves_Logged; Move++)
+ {
+  Bytes[Length++] = Game->Move_Log[Move].From;
+  Bytes[Length++] = Game->Move_Log[Move].Over;
+  Bytes[Length++] = Game->Move_Log[Move].To;
+ }
+
+ Crc = Save_Crc32(Bytes, Length);
+ for (Byte = 0; Byte < 4; Byte++)
+    Bytes[Length++] = (unsigned char) (Crc >> (8 * Byte));
+
+ return Length;
+}
+
+
+/*FUNCTION:*/
+int Save_Decode(const unsigned char *Bytes, size_t Length,
+                struct Peg_Game *Game)
+{
+ /*Fills Game from Length bytes of a save file. Returns 1 when the file is
+   valid & 0 otherwise, Game is then left in an unspecified state. A file
+   without a move log may still count jumps made, Moves_Made is then 0 so
+   nothing can be undone past the load*/
+
+ uint64_t Packed = 0;
+ uint32_t Crc    = 0;
+ int      Move, Byte, Logged;
+
+
+ if (Length < SAVE_MIN_BYTES || Length > SAVE_MAX_BYTES ||
+     (Length - SAVE_MIN_BYTES) % 3 != 0)
+   return 0;
+
+ if (memcmp(Bytes, "PEGS", 4) != 0 || Bytes[4] != SAVE_VERSION ||
+     (Bytes[5] & ~(SAVE_FLAG_LOG | SAVE_FLAG_GEOMETRY)) != 0 ||
+     (Bytes[5] & SAVE_FLAG_GEOMETRY) != SAVE_GEOMETRY)
+   return 0;
+
+ for (Byte = 3; Byte >= 0; Byte--)
+    Crc = Crc << 8 | Bytes[Length - 4 + Byte];
+
+ if (Crc != Save_Crc32(Bytes, Length - 4))
+   return 0;
+
+ for (Byte = 7; Byte >= 0; Byte--)
+    Packed = Packed << 8 | Bytes[6 + Byte];
+
+ if (Packed >> BOARD_HOLES)
+   return 0;
+
+ Game->Pegs         = Bitboard_Unpack(Packed);
+ Game->Cursor_Row   = Bytes[14];
+ Game->Cursor_Col   = Bytes[15];
+ Game->Selected_Row = Bytes[16];
+ Game->Selected_Col = Bytes[17];
+ Game->Moves_Made   = Bytes[18];
+ Game->Moves_Logged = Bytes[19];
+ Logged             = (int) (Length - SAVE_MIN_BYTES) / 3;
+
+ /*The log flag, the logged count & the file size must agree*/
+ if (Logged != Game->Moves_Logged ||
+     (Logged > 0) != ((Bytes[5] & SAVE_FLAG_LOG) != 0) ||
+     Game->Moves_Made > BOARD_HOLES - 1 ||
+     (Logged > 0 && Game->Moves_Made > Logged))
+   return 0;
+
+ if (Game->Cursor_Row >= BOARD_SIZE || Game->Cursor_Col >= BOARD_SIZE ||
+     !Bitboard_Test(Valid_Holes,
+                    HOLE_INDEX(Game->Cursor_Row, Game->Cursor_Col)))
+   return 0;
+
+ if (Game->Selected_Row != GAME_NONE || Game->Selected_Col != GAME_NONE)
+   if (Game->Selected_Row >= BOARD_SIZE || Game->Selected_Col >= BOARD_SIZE ||
+       !Bitboard_Test(Game->Pegs,
+                      HOLE_INDEX(Game->Selected_Row, Game->Selected_Col)))
+     return 0;
+
+ for (Move = 0; Move < Logged; Move++)
+ {
+  Game->Move_Log[Move].From = Bytes[20 + 3 * Move];
+  Game->Move_Log[Move].Over = Bytes[21 + 3 * Move];
+  Game->Move_Log[Move].To   = Bytes[22 + 3 * Move];
+ }
+
+ if (!Save_Check_Log(Game))
+   return 0;
+
+ Game->Key   = Zobrist_Hash(Game->Pegs);
+ Game->Beads = Bitboard_Count(Game->Pegs);
+ if (Logged == 0) Game->Moves_Made = 0;
+ return 1;
+}
+
+
+/*FUNCTION:*/
+static int Save_Check_Log(const struct Peg_Game *Game)
+{
+ /*Every logged jump must be a jump of the cross, the made ones must undo
+   from the saved board & the rest must then redo from it*/
+
+ struct Bitboard    Pegs = Game->Pegs;
+ const struct Jump *Move;
+ int                Index, Jump;
+
+
+ for (Index = 0; Index < Game->Moves_Logged; Index++)
+ {
+  Move = &Game->Move_Log[Index];
+  Jump = Jump_Find(Move->From, Move->To);
+  if (Jump < 0 || Jump_Table[Jump].Over != Move->Over)
+    return 0;
+ }
+
+ for (Index = Game->Moves_Made - 1; Index >= 0 && Game->Moves_Logged; Index--)
+ {
+  Move = &Game->Move_Log[Index];
+  if (!Bitboard_Test(Pegs, Move->To) || Bitboard_Test(Pegs, Move->Over) ||
+      Bitboard_Test(Pegs, Move->From))
+    return 0;
+
+  Pegs = Bitboard_Toggle(Pegs, Move->From, Move->Over, Move->To);
+ }
+
+ for (Pegs = Game->Pegs, Index = Game->Moves_Made;
+      Index < Game->Moves_Logged; Index++)
+ {
+  Move = &Game->Move_Log[Index];
+  if (!Bitboard_Jump(&Pegs, Move->From, Move->To))
+    return 0;
+ }
+
+ return 1;
+}
+
+
+/*FUNCTION:*/
+int Save_Write(const char *Path, const struct Peg_Game *Game)
+{
+ /*Returns 1 when the whole file was written*/
+
+ unsigned char Bytes[SAVE_MAX_BYTES];
+ size_t        Length = Save_Encode(Game, Bytes);
+ FILE         *fp     = fopen(Path, "wb");
+ int           Written;
+
+
+ if (fp == NULL)
+   return 0;
+
+ Written = fwrite(Bytes, 1, Length, fp) == Length;
+ return (fclose(fp) == 0) && Written;
+}
+
+
+/*FUNCTION:*/
+int Save_Read(const char *Path, struct Peg_Game *Game)
+{
+ /*Returns 1 when Path holds a valid save, a file longer than the largest
+   save is rejected without looking at it further*/
+
+ unsigned char Bytes[SAVE_MAX_BYTES + 1];
+ size_t        Length;
+ FILE         *fp = fopen(Path, "rb");
+
+
+ if (fp == NULL)
+   return 0;
+
+ Length = fread(Bytes, 1, sizeof(Bytes), fp);
+ fclose(fp);
+
+ return Save_Decode(Bytes, Length, Game);
+}
+
+
+/*FUNCTION:*/
+uint32_t Save_Crc32(const unsigned char *Bytes, size_t Length)
+{
+ /*CRC-32 as used by zip & png (reflected polynomial 0xedb88320), a bit at
+   a time: a save is at most 159 bytes so a lookup table would not pay*/
+
+ uint32_t Crc = 0xffffffff;
+ int      Bit;
+
+
+ while (Length--)
+ {
+  Crc ^= *Bytes++;
+  for (Bit = 0; Bit < 8; Bit++)
+     Crc = (Crc >> 1) ^ (0xedb88320 & -(Crc & 1));
+ }
+
+ return ~Crc;
+}
@@ -0,0 +1,50 @@
+/*Date:    17Oct2026Sat 13:10
+//File:    peg_save.h
+//Desc:    Versioned binary save file shared by the Peg Solitaire front ends,
+           the serialized form of a struct Peg_Game (see peg_game.h).
+           Every field is written byte by byte in little endian order so a
+           file moves between machines, compilers & word sizes unchanged.
+
+           Layout of version 1, 24 bytes + 3 per logged jump:
+
+            offset size
+              0     4   magic "PEGS"
+              4     1   version
+              5     1   flags, bit 0 set when a move log follows, bits 1
+                        & 2 the PEG_GEOMETRY of the board, 0 for the cross
+              6     8   board, Bitboard_Pack of the beads
+             14     2   cursor row & column
+             16     2   selected bead row & column, 255 for none
+             18     1   jumps made (undo depth)
+             19     1   jumps logged (undo + redo depth)
+             20   3 n   move log: from, over & to hole of n logged jumps
+           20+3n    4   CRC-32 of every byte before it
+*/
+
+
+#ifndef PEG_SAVE_H
+#define PEG_SAVE_H
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include <stddef.h>
+#include "peg_game.h"
+
+#define SAVE_VERSION   1
+#define SAVE_MIN_BYTES 24
+#define SAVE_MAX_BYTES (SAVE_MIN_BYTES + 3 * BOARD_HOLES)
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+size_t   Save_Encode(const struct Peg_Game *Game, unsigned char *Bytes);
+int      Save_Decode(const unsigned char *Bytes, size_t Length,
+                     struct Peg_Game *Game);
+int      Save_Write(const char *Path, const struct Peg_Game *Game);
+int      Save_Read(const char *Path, struct Peg_Game *Game);
+uint32_t Save_Crc32(const unsigned char *Bytes, size_t Length);
+
+#endif
@@ -0,0 +1,235 @@
+/*Date:    17Oct2026Sat 16:20
+//File:    peg_session.c
+//Desc:    Runs the line protocol commands of peg_session.h on 1 session.
+*/
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include <stdio.h>
+#include "peg_command.h"
+#include "peg_session.h"
+
+#define SESSION_SAVED ((uint64_t) 1 << 63) /*Saved holds a game*/
+#define SESSION_NONE  15                   /*GAME_NONE in a 4 bit field*/
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+static void   Session_New(struct Peg_Session *Session);
+static void   Session_Move(struct Peg_Session *Session, int Row_Step,
+                           int Col_Step, char *Reply, size_t *Length);
+static void   Session_Select(struct Peg_Session *Session, char *Reply,
+                             size_t *Length);
+static void   Session_Save(struct Peg_Session *Session);
+static int    Session_Load(struct Peg_Session *Session);
+
+
+/*--------------------
+//Function Definitions (Implementation)
+--------------------*/
+
+
+/*FUNCTION:*/
+void Session_Init(struct Peg_Session *Session)
+{
+ Session->Saved = 0;
+ Session_New(Session);
+}
+
+
+/*FUNCTION:*/
+static void Session_New(struct Peg_Session *Session)
+{
+ /*A new game, whatever was saved is kept*/
+
+ Session->Pegs         = Start_Pegs;
+ Session->Cursor_Row   = BOARD_CENTRE / BOARD_STRIDE;
+ Session->Cursor_Col   = BOARD_CENTRE % BOARD_STRIDE;
+ Session->Selected_Row = GAME_NONE;
+ Session->Selected_Col = GAME_NONE;
+}
+
+
+/*FUNCTION:*/
+size_t Session_Command(struct Peg_Session *Session, const char *Command,
+                       size_t Length, char Reply[SESSION_REPLY_BYTES])
+{
+ /*Command is 1 line of Length bytes without its newline, a trailing
+   carriage return is ignored. Returns the length of the reply written to
+   Reply, newline included. Front end only commands like help are errors*/
+
+ size_t Reply_Length = 0;
+
+
+ if (Length > 0 && Command[Length - 1] == '\r') Length--;
+
+ switch (Command_Token(Command, Length))
+ {
+  case Command_Up:     Session_Move(Session, -1,  0, Reply, &Reply_Length);
+  break;
+
+  case Command_Down:   Session_Move(Session,  1,  0, Reply, &Reply_Length);
+  break;
+
+  case Command_Left:   Session_Move(Session,  0, -1, Reply, &Reply_Length);
+  break;
+
+  case Command_Right:  Session_Move(Session,  0,  1, Reply, &Reply_Length);
+  break;
+
+  case Command_Select: Session_Select(Session, Reply, &Reply_Length);
+  break;
+
+  case Command_New:
+       Session_New(Session);
+       Reply_Length = sprintf(Reply, "new\n");
+  break;
+
+
+  case Command_Save:
+       Session_Save(Session);
+       Reply_Length = sprintf(Reply, "saved\n");
+  break;
+
+
+  case Command_Load:
+       Reply_Length = sprintf(Reply, Session_Load(Session) ? "loaded\n"
+                                                           : "nosave\n");
+  break;
+
+
+  case Command_Board:
+       Reply_Length = sprintf(Reply, "board %llx %d %d\n",
+                              (unsigned long long) Bitboard_Pack(Session->Pegs),
+                              Session->Cursor_Row, Session->Cursor_Col);
+  break;
+
+
+  default:
+       Reply_Length = sprintf(Reply, "error\n");
+  break;
+ }
+
+ return Reply_Length;
+}
+
+
+/*FUNCTION:*/
+static void Session_Move(struct Peg_Session *Session, int Row_Step,
+                         int Col_Step, char *Reply, size_t *Length)
+{
+ /*Steps to the next hole of the board in that direction, from an edge the
+   cursor wraps around to the far end of its row or column*/
+
+ int Row = Session->Cursor_Row,
+     Col = Session->Cursor_Col;
+
+
+ do
+ {
+  Row = (Row + Row_Step + BOARD_SIZE) % BOARD_SIZE;
+  Col = (Col + Col_Step + BOARD_SIZE) % BOARD_SIZE;
+ }
+ while (!Bitboard_Test(Valid_Holes, HOLE_INDEX(Row, Col)));
+
+ Session->Cursor_Row = Row;
+ Session->Cursor_Col = Col;
+ *Length = sprintf(Reply, "cursor %d %d\n", Row, Col);
+}
+
+
+/*FUNCTION:*/
+static void Session_Select(struct Peg_Session *Session, char *Reply,
+                           size_t *Length)
+{
+ /*The select command of the front ends: picks up or puts down the bead
+   under the cursor, or jumps the selected bead to the cursor*/
+
+ int Cursor = HOLE_INDEX(Session->Cursor_Row, Session->Cursor_Col),
+     Beads;
+
+
+ if (!Bitboard_Test(Session->Pegs, Cursor))
+ {
+  if (Session->Selected_Row == GAME_NONE)
+  {
+   *Length = sprintf(Reply, "empty\n");
+   return;
+  }
+
+  if (!Bitboard_Jump(&Session->Pegs,
+                     HOLE_INDEX(Session->Selected_Row, Session->Selected_Col),
+                     Cursor))
+  {
+   *Length = sprintf(Reply, "illegal\n");
+   return;
+  }
+
+  Session->Selected_Row = Session->Selected_Col = GAME_NONE;
+  Beads = Bitboard_Count(Session->Pegs);
+
+  if (Bitboard_Is_Won(Session->Pegs))
+    *Length = sprintf(Reply, "won\n");
+  else if (Bitboard_Mobility(Session->Pegs) == 0)
+    *Length = sprintf(Reply, "stalemate %d\n", Beads);
+  else *Length = sprintf(Reply, "jumped %d\n", Beads);
+ }
+ else if (Session->Selected_Row == GAME_NONE)
+ {
+  Session->Selected_Row = Session->Cursor_Row;
+  Session->Selected_Col = Session->Cursor_Col;
+  *Length = sprintf(Reply, "selected %d %d\n", Session->Cursor_Row,
+                    Session->Cursor_Col);
+ }
+ else if (Session->Selected_Row == Session->Cursor_Row &&
+          Session->Selected_Col == Session->Cursor_Col)
+ {
+  Session->Selected_Row = Session->Selected_Col = GAME_NONE;
+  *Length = sprintf(Reply, "deselected\n");
+ }
+ else *Length = sprintf(Reply, "busy\n");
+}
+
+
+/*FUNCTION:*/
+static void Session_Save(struct Peg_Session *Session)
+{
+ /*The whole game fits 1 word: BOARD_HOLES bits of board (45 on the cross),
+   then 4 bits each for the cursor row & column & the selected row & column*/
+
+ Session->Saved = SESSION_SAVED | Bitboard_Pack(Session->Pegs) |
+                  ((uint64_t) Session->Cursor_Row                          |
+                   (uint64_t) Session->Cursor_Col                    << 4  |
+                   (uint64_t) (Session->Selected_Row & SESSION_NONE) << 8  |
+                   (uint64_t) (Session->Selected_Col & SESSION_NONE) << 12) <<
+                  BOARD_HOLES;
+}
+
+
+/*FUNCTION:*/
+static int Session_Load(struct Peg_Session *Session)
+{
+ /*Returns 0 when nothing was saved*/
+
+ uint64_t Saved = Session->Saved;
+
+
+ if (!(Saved & SESSION_SAVED))
+   return 0;
+
+ Session->Pegs         = Bitboard_Unpack(Saved &
+                                         (((uint64_t) 1 << BOARD_HOLES) - 1));
+ Saved               >>= BOARD_HOLES;
+ Session->Cursor_Row   =  Saved        & 15;
+ Session->Cursor_Col   = (Saved >>  4) & 15;
+ Session->Selected_Row = (Saved >>  8) & 15;
+ Session->Selected_Col = (Saved >> 12) & 15;
+
+ if (Session->Selected_Row == SESSION_NONE)
+   Session->Selected_Row = Session->Selected_Col = GAME_NONE;
+
+ return 1;
+}
@@ -0,0 +1,62 @@
+/*Date:    17Oct2026Sat 16:20
+//File:    peg_session.h
+//Desc:    1 player of the line protocol spoken by peg_solitaire_server. A
+           session is the board, cursor, selection & 1 saved game in 32
+           bytes, with no move log & no screen, so a server can hold a
+           million of them. Session_Command runs 1 command line & writes 1
+           reply line, the rules are those of the select command of the
+           front ends.
+
+           Commands & replies, 1 per line:
+            up down left right  cursor R C
+            select              selected R C | deselected | empty | busy |
+                                illegal | jumped B | won | stalemate B
+            new                 new
+            save                saved
+            load                loaded | nosave
+            board               board PACKED R C, PACKED as in Bitboard_Pack
+            anything else       error
+           R C are a row & column 0 to 8, B the beads left. The cursor wraps
+           around the cross the way it does in the front ends. The aliases
+           of peg_command.h work too, k j h l for the cursor, s for select &
+           restart for new.
+*/
+
+
+#ifndef PEG_SESSION_H
+#define PEG_SESSION_H
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include <stddef.h>
+#include "peg_game.h"
+
+#define SESSION_REPLY_BYTES 32 /*longest reply with its newline & a NUL*/
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+struct Peg_Session
+{
+ struct Bitboard Pegs;
+ uint64_t        Saved;        /*0 or SESSION_SAVED | packed board | cursor &
+                                 selection above the board, see
+                                 Session_Save*/
+ unsigned char   Cursor_Row,
+                 Cursor_Col,
+                 Selected_Row, /*GAME_NONE when no bead is selected*/
+                 Selected_Col;
+};
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+void   Session_Init(struct Peg_Session *Session);
+size_t Session_Command(struct Peg_Session *Session, const char *Command,
+                       size_t Length, char Reply[SESSION_REPLY_BYTES]);
+
+#endif
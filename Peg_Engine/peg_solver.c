@@ -0,0 +1,993 @@
+/*Date:    17Oct2026Sat 10:05
+//File:    peg_solver.c
+//Desc:    Depth first search over the jumps produced by Bitboard_Legal_Jumps.
+           Every jump removes 1 bead, so a position with n beads is always n
+           jumps away from the start of its line & the search tree is at most
+           44 deep. A position that cannot reach the goal is stored in the dead
+           table keyed on the smallest of its 8 rotations / reflections
+           (Symmetry_Canonical of the 45 bit packed form). That is an exact
+           key, so a table hit never gives a wrong answer, & 1 entry covers
+           all the symmetric copies of a position.
+
+           The table is a fixed size open addressing cache: when a probe run
+           is full its first slot is overwritten. Losing an entry
+           only costs a repeated search, never a wrong result. Whether a
+           position is dead does not depend on where the search started, so
+           the table is kept from 1 Solver_Solve to the next (a hint after a
+           jump or the next board of a batch starts warm) until Solver_Free.
+
+           With an endgame database open (peg_database.h) a position it
+           covers is answered by 1 lookup: a lost one is cut at once & below a
+           winnable one only winnable children survive, so the line to the
+           goal is found without any search.
+
+           Ahead of both, every node is tested against the pagoda functions
+           of peg_pagoda.h, whose sums ride down the search & cost 1 add per
+           jump: most positions a few jumps into a game are already lost on
+           them & their whole subtree goes without a table probe. A board
+           outside the position class of the finish is answered before any
+           search at all.
+
+           Solver_Longest answers the other batch question, the most jumps
+           still possible from a position, with its own table of canonical
+           key & jump count.
+
+           Solver_Meet searches from both ends instead: whole layers of
+           canonical keys, forward from the position by jumps & backward from
+           the finish by unjumps (Bitboard_Legal_Unjumps), each layer a sorted
+           array so the 2 sides meet in 1 merge join. The pagodas cut both
+           sides, forward the children that cannot finish & backward the
+           parents with a sum above that of every rotation / reflection of
+           the position, which no line from it can reach (a layer holds
+           canonical boards & the pagodas are not symmetric). Lost boards &
+           boards 20 or more jumps into a game settle with far fewer boards
+           expanded than depth first; from the start both sides grow alike &
+           the layers in the middle are too big.
+
+           Parallel search: the first SOLVER_SPLIT_DEPTH levels of the jump
+           tree are cut into tasks (none with 1 thread), every worker thread
+           owns a deque of tasks & steals from the other deques when its own
+           runs dry. Below the split depth a task is searched depth first.
+           All workers share the dead table, slots are read & claimed with
+           atomic operations so no lock is taken per node. The first worker
+           to reach the goal sets Stop & every other worker unwinds at its
+           next node.
+*/
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include "peg_database.h"
+#include "peg_pagoda.h"
+#include "peg_solver.h"
+
+#define PROBE_LENGTH       8
+#define NODE_BATCH         4096 /*nodes counted locally before the shared add*/
+#define SOLVER_SPLIT_DEPTH 4    /*levels below the root that become tasks*/
+#define LONGEST_TABLE_BITS 20   /*2^20 longest lines, 8MB*/
+#define MEET_LAYER_START   4096 /*keys a meet layer is first allocated for*/
+
+#define STOP_NONE  0
+#define STOP_FOUND 1
+#define STOP_LIMIT 2
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+struct Solver_Task
+{
+ struct Bitboard    Pegs;
+ int                Depth;             /*jumps made from the root*/
+ struct Solver_Jump Path[BOARD_HOLES]; /*the jumps from the root to Pegs*/
+};
+
+struct Worker
+{
+ struct Solver      *S;
+ pthread_t           Thread;
+ int                 Running;   /*1 when Thread was started*/
+ pthread_mutex_t     Lock;      /*guards the deque*/
+ struct Solver_Task *Tasks;     /*deque: owner works at Bottom, thieves at Top*/
+ int                 Top,
+                     Bottom,
+                     Capacity;
+ uint64_t            Nodes;     /*not yet added to S->Nodes*/
+ struct Solver_Jump  Line[BOARD_HOLES];
+};
+
+/*1 layer of the meet in the middle search: every board of 1 bead count
+  found from 1 side, as canonical keys*/
+struct Meet_Layer
+{
+ uint64_t *Keys;     /*sorted & unique once the layer is complete*/
+ size_t    Count,
+           Capacity;
+};
+
+struct Solver
+{
+ uint64_t             *Dead;       /*canonical keys, 0 marks an empty slot*/
+ uint64_t              Mask;       /*table size - 1*/
+ uint64_t              Node_Limit; /*0 for no limit*/
+ uint64_t              Nodes;      /*atomic*/
+ long                  Pending;    /*atomic, tasks queued or being searched*/
+ int                   Stop;       /*atomic, STOP_NONE / FOUND / LIMIT*/
+ int                   Threads;
+ int                   Split_Depth; /*0 with 1 thread, plain depth first*/
+ int                   Root_Depth; /*beads on the root board - 1*/
+ struct Worker        *Workers;
+ struct Solver_Result *Result;
+};
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+static void *Worker_Run(void *Argument);
+static void  Worker_Task(struct Worker *W, struct Solver_Task *Task);
+static int   Worker_Push(struct Worker *W, struct Solver_Task *Task);
+static int   Worker_Pop(struct Worker *W, struct Solver_Task *Task);
+static int   Worker_Steal(struct Worker *Thief, struct Solver_Task *Task);
+static int   Solver_Search(struct Worker *W, struct Bitboard Pegs,
+                           struct Pagoda_Sums Sums, int Depth);
+static void  Solver_Count(struct Worker *W);
+static int   Dead_Lookup(struct Solver *S, uint64_t Key);
+static void  Dead_Insert(struct Solver *S, uint64_t Key);
+static int   Longest_Search(struct Bitboard Pegs, uint64_t *Nodes_Left);
+static int   Meet_Expand(struct Meet_Layer *Layer, struct Meet_Layer *Next,
+                         int Backward, struct Bitboard Start,
+                         uint64_t *Nodes_Left);
+static int   Meet_Step(struct Bitboard *Pegs, const struct Meet_Layer *Layer,
+                       struct Solver_Jump *Jump);
+static int   Layer_Add(struct Meet_Layer *Layer, uint64_t Key);
+static void  Layer_Sort(struct Meet_Layer *Layer);
+static int   Layer_Find(const struct Meet_Layer *Layer, uint64_t Key);
+static int   Key_Compare(const void *A, const void *B);
+
+
+/*----------------------------
+//Global Variable Declarations
+----------------------------*/
+static uint64_t *Dead_Table;    /*kept between calls, see Solver_Free*/
+static uint64_t *Longest_Table; /*canonical key << 6 | jumps + 1, 0 is empty*/
+
+
+/*--------------------
+//Function Definitions (Implementation)
+--------------------*/
+
+
+/*FUNCTION:*/
+int Solver_Solve(struct Bitboard Pegs, int Threads, uint64_t Node_Limit,
+                 struct Solver_Result *Result)
+{
+ /*Library entry point. Searches with Threads worker threads, the calling
+   thread being 1 of them. Returns Result->Solvable, on a 1 the jumps that
+   reach the goal are in Result->Solution[0 to Moves - 1]. Not reentrant,
+   only 1 call may run at a time as every call shares the dead table*/
+
+ struct Solver      S;
+ struct Solver_Task Root;
+ int                Index;
+
+
+ Result->Solvable = 0;
+ Result->Moves    = 0;
+ Result->Nodes    = 0;
+
+ if (Threads < 1) Threads = 1;
+
+ Symmetry_Init();
+ Pagoda_Init();
+
+ Pegs = Bitboard_And(Pegs, Valid_Holes);
+ if (Position_Class_Lost(Pegs))
+   return 0;
+
+ memset(&S, 0, sizeof(S));
+ S.Mask        = ((uint64_t) 1 << SOLVER_TABLE_BITS) - 1;
+ if (Dead_Table == NULL)
+   Dead_Table  = calloc(S.Mask + 1, sizeof(uint64_t));
+ S.Dead        = Dead_Table;
+ S.Workers     = calloc(Threads, sizeof(struct Worker));
+ S.Node_Limit  = Node_Limit;
+ S.Threads     = Threads;
+ S.Split_Depth = Threads > 1 ? SOLVER_SPLIT_DEPTH : 0;
+ S.Result      = Result;
+
+ if (S.Dead == NULL || S.Workers == NULL)
+ {
+  free(S.Workers);
+  Result->Solvable = -1;
+  return -1;
+ }
+
+ for (Index = 0; Index < Threads; Index++)
+ {
+  S.Workers[Index].S = &S;
+  pthread_mutex_init(&S.Workers[Index].Lock, NULL);
+ }
+
+ Root.Pegs    = Pegs;
+ Root.Depth   = 0;
+ S.Root_Depth = Bitboard_Count(Root.Pegs) - 1;
+ S.Pending    = 1;
+
+ if (!Worker_Push(&S.Workers[0], &Root))
+   S.Stop = STOP_LIMIT;
+
+ /*Worker 0 is the calling thread. A worker that fails to start leaves its
+   empty deque behind & the others simply never find anything to steal*/
+ for (Index = 1; Index < Threads; Index++)
+    S.Workers[Index].Running = pthread_create(&S.Workers[Index].Thread, NULL,
+                                              Worker_Run,
+                                              &S.Workers[Index]) == 0;
+
+ Worker_Run(&S.Workers[0]);
+
+ for (Index = 0; Index < Threads; Index++)
+ {
+  if (S.Workers[Index].Running)
+    pthread_join(S.Workers[Index].Thread, NULL);
+
+  pthread_mutex_destroy(&S.Workers[Index].Lock);
+  free(S.Workers[Index].Tasks);
+ }
+
+ if (S.Stop == STOP_FOUND)
+ {
+  Result->Solvable = 1;
+  Result->Moves    = S.Root_Depth;
+ }
+ else if (S.Stop == STOP_LIMIT)
+   Result->Solvable = -1;
+
+ Result->Nodes = S.Nodes;
+
+ free(S.Workers);
+ return Result->Solvable;
+}
+
+
+/*FUNCTION:*/
+int Solver_Longest(struct Bitboard Pegs, uint64_t Node_Limit)
+{
+ /*Most jumps that can still be made from Pegs, beads now - fewest beads the
+   position can be brought down to. -1 when Node_Limit (0 for no limit) runs
+   out or the table cannot be allocated. Single threaded*/
+
+ uint64_t Nodes_Left = Node_Limit ? Node_Limit : UINT64_MAX;
+
+
+ if (Longest_Table == NULL)
+   Longest_Table = calloc((size_t) 1 << LONGEST_TABLE_BITS, sizeof(uint64_t));
+
+ if (Longest_Table == NULL)
+   return -1;
+
+ Symmetry_Init();
+ return Longest_Search(Bitboard_And(Pegs, Valid_Holes), &Nodes_Left);
+}
+
+
+/*FUNCTION:*/
+int Solver_Meet(struct Bitboard Pegs, int Meet_Pegs, uint64_t Node_Limit,
+                struct Solver_Result *Result)
+{
+ /*Meet in the middle: breadth first forward from Pegs by jumps & backward
+   from the finish by unjumps, 1 whole layer of canonical keys per bead
+   count, until both sides hold boards of the same count. Any key in both
+   layers lies on a line from Pegs to the finish. Meet_Pegs is that count, 0
+   lets each step grow the side whose last layer is smaller. Returns
+   Result->Solvable like Solver_Solve, -1 when Node_Limit (0 for no limit)
+   boards were expanded or memory ran out. Single threaded, shares no table
+   with Solver_Solve*/
+
+ struct Meet_Layer  Forward[BOARD_HOLES + 1], Backward[BOARD_HOLES + 1];
+ struct Solver_Jump Jump;
+ struct Bitboard    Line;
+ uint64_t           Nodes_Left = Node_Limit ? Node_Limit : UINT64_MAX;
+ size_t             Index, Other, Kept;
+ int                Beads, Ahead, Behind, Grown = 1, Depth;
+
+
+ Result->Solvable = 0;
+ Result->Moves    = 0;
+ Result->Nodes    = 0;
+
+ Symmetry_Init();
+ Pagoda_Init();
+
+ Pegs  = Bitboard_And(Pegs, Valid_Holes);
+ Beads = Bitboard_Count(Pegs);
+
+ if (Beads == 0 || Position_Class_Lost(Pegs) ||
+     Pagoda_Lost(Pagoda_Evaluate(Pegs), Beads))
+   return 0;
+
+ if (Meet_Pegs < 0 || Meet_Pegs > Beads)
+   Meet_Pegs = 0;
+
+ memset(Forward,  0, sizeof(Forward));
+ memset(Backward, 0, sizeof(Backward));
+
+ Ahead  = Beads; /*bead count of the last layer of each side*/
+ Behind = 1;
+
+ if (!Layer_Add(&Forward[Ahead], Symmetry_Canonical(Bitboard_Pack(Pegs))) ||
+     !Layer_Add(&Backward[Behind],
+                Symmetry_Canonical(Bitboard_Pack(Bitboard_Bit(BOARD_CENTRE)))))
+   Grown = -1;
+
+ while (Grown == 1 && Ahead > Behind)
+ {
+  if (Meet_Pegs ? Ahead > Meet_Pegs
+                : Forward[Ahead].Count <= Backward[Behind].Count)
+  {
+   Grown = Meet_Expand(&Forward[Ahead], &Forward[Ahead - 1], 0, Pegs,
+                       &Nodes_Left);
+   Ahead--;
+  }
+  else
+  {
+   Grown = Meet_Expand(&Backward[Behind], &Backward[Behind + 1], 1, Pegs,
+                       &Nodes_Left);
+   Behind++;
+  }
+ }
+
+ /*Merge join of the 2 sorted layers, the first common key is kept alone*/
+ for (Index = Other = 0; Grown == 1 && Index < Forward[Ahead].Count &&
+                         Other < Backward[Behind].Count && !Result->Solvable;)
+    if (Forward[Ahead].Keys[Index] < Backward[Behind].Keys[Other])
+      Index++;
+    else if (Forward[Ahead].Keys[Index] > Backward[Behind].Keys[Other])
+      Other++;
+    else
+    {
+     Forward[Ahead].Keys[0] = Forward[Ahead].Keys[Index];
+     Forward[Ahead].Count   = 1;
+     Result->Solvable       = 1;
+    }
+
+ if (Grown < 0)
+   Result->Solvable = -1;
+
+ if (Result->Solvable == 1)
+ {
+  /*Each forward layer is cut down to the boards with a jump into the layer
+    below it, so the layers lead only to the meeting board. Then from Pegs
+    every step has a jump into the next layer, forward down to the meeting
+    board & backward down to the finish*/
+  for (Depth = Ahead + 1; Depth <= Beads; Depth++)
+  {
+   for (Index = Kept = 0; Index < Forward[Depth].Count; Index++)
+   {
+    Line = Bitboard_Unpack(Forward[Depth].Keys[Index]);
+    if (Meet_Step(&Line, &Forward[Depth - 1], &Jump))
+      Forward[Depth].Keys[Kept++] = Forward[Depth].Keys[Index];
+   }
+
+   Forward[Depth].Count = Kept;
+  }
+
+  for (Line = Pegs, Depth = Beads; Depth > 1; Depth--)
+     Meet_Step(&Line, Depth > Ahead ? &Forward[Depth - 1]
+                                    : &Backward[Depth - 1],
+               &Result->Solution[Beads - Depth]);
+
+  Result->Moves = Beads - 1;
+ }
+
+ Result->Nodes = (Node_Limit ? Node_Limit : UINT64_MAX) - Nodes_Left;
+
+ for (Depth = 0; Depth <= BOARD_HOLES; Depth++)
+ {
+  free(Forward[Depth].Keys);
+  free(Backward[Depth].Keys);
+ }
+
+ return Result->Solvable;
+}
+
+
+/*FUNCTION:*/
+void Solver_Free(void)
+{
+ /*Releases the tables kept between calls, the next call starts cold*/
+
+ free(Dead_Table);
+ free(Longest_Table);
+ Dead_Table    = NULL;
+ Longest_Table = NULL;
+}
+
+
+/*FUNCTION:*/
+static void *Worker_Run(void *Argument)
+{
+ /*Takes tasks from the own deque, then from the others, until a solution is
+   found, the node limit runs out or no task is left anywhere*/
+
+ struct Worker     *W = Argument;
+ struct Solver_Task Task;
+
+
+ while (__atomic_load_n(&W->S->Stop, __ATOMIC_RELAXED) == STOP_NONE)
+ {
+  if (Worker_Pop(W, &Task) || Worker_Steal(W, &Task))
+  {
+   Worker_Task(W, &Task);
+   __atomic_sub_fetch(&W->S->Pending, 1, __ATOMIC_ACQ_REL);
+  }
+  else if (__atomic_load_n(&W->S->Pending, __ATOMIC_ACQUIRE) == 0)
+    break;
+  else sched_yield();
+ }
+
+ Solver_Count(W);
+ return NULL;
+}
+
+
+/*FUNCTION:*/
+static void Worker_Task(struct Worker *W, struct Solver_Task *Task)
+{
+ /*Shallow tasks are split into 1 task per legal jump, deeper tasks are
+   searched by this worker alone*/
+
+ struct Solver      *S = W->S;
+ struct Solver_Task  Child;
+ struct Jump_Masks   Jumps;
+ struct Bitboard     Origins;
+ struct Pagoda_Sums  Sums;
+ unsigned char       Move_From[JUMP_DIRECTIONS * BOARD_HOLES],
+                     Move_Direction[JUMP_DIRECTIONS * BOARD_HOLES];
+ int                 Direction, From, Found, Moves;
+
+
+ Sums = Pagoda_Evaluate(Task->Pegs);
+
+ if (Task->Depth < S->Split_Depth && Bitboard_Count(Task->Pegs) > 1)
+ {
+  W->Nodes++;
+  if (Pagoda_Lost(Sums, Bitboard_Count(Task->Pegs)) ||
+      Dead_Lookup(S, Symmetry_Canonical(Bitboard_Pack(Task->Pegs))))
+    return;
+
+  Bitboard_Legal_Jumps(Task->Pegs, &Jumps);
+
+  for (Direction = Jump_Up, Moves = 0; Direction < JUMP_DIRECTIONS; Direction++)
+  {
+   Origins = Jumps.From[Direction];
+
+   while (!Bitboard_Is_Empty(Origins))
+   {
+    Move_From[Moves]        = Bitboard_Pop(&Origins);
+    Move_Direction[Moves++] = Direction;
+   }
+  }
+
+  /*Pushed last jump first so the owner pops them in the same order as the
+    depth first search would try them*/
+  Child = *Task;
+  Child.Depth++;
+
+  while (Moves--)
+  {
+   From      = Move_From[Moves];
+   Direction = Move_Direction[Moves];
+   Child.Path[Task->Depth].From = From;
+   Child.Path[Task->Depth].Over = From + Jump_Offset[Direction];
+   Child.Path[Task->Depth].To   = From + 2 * Jump_Offset[Direction];
+   Child.Pegs = Bitboard_Toggle(Task->Pegs, From,
+                                From + Jump_Offset[Direction],
+                                From + 2 * Jump_Offset[Direction]);
+
+   __atomic_add_fetch(&S->Pending, 1, __ATOMIC_ACQ_REL);
+   if (!Worker_Push(W, &Child))
+   {
+    /*Out of memory for the deque, the child is searched here instead*/
+    __atomic_sub_fetch(&S->Pending, 1, __ATOMIC_ACQ_REL);
+    Worker_Task(W, &Child);
+   }
+  }
+
+  return;
+ }
+
+ Found = Solver_Search(W, Task->Pegs, Sums, Task->Depth);
+
+ /*First solution wins, the path to the task & the line below it are joined*/
+ if (Found == 1 &&
+     __atomic_exchange_n(&S->Stop, STOP_FOUND, __ATOMIC_ACQ_REL) != STOP_FOUND)
+ {
+  memcpy(S->Result->Solution, Task->Path,
+         Task->Depth * sizeof(struct Solver_Jump));
+  memcpy(S->Result->Solution + Task->Depth, W->Line + Task->Depth,
+         (S->Root_Depth - Task->Depth) * sizeof(struct Solver_Jump));
+ }
+}
+
+
+/*FUNCTION:*/
+static int Worker_Push(struct Worker *W, struct Solver_Task *Task)
+{
+ struct Solver_Task *Grown;
+ int                 Capacity;
+
+
+ pthread_mutex_lock(&W->Lock);
+
+ if (W->Bottom == W->Capacity)
+ {
+  Capacity = W->Capacity ? W->Capacity * 2 : 64;
+  Grown    = realloc(W->Tasks, Capacity * sizeof(struct Solver_Task));
+  if (Grown == NULL)
+  {
+   pthread_mutex_unlock(&W->Lock);
+   return 0;
+  }
+
+  W->Tasks    = Grown;
+  W->Capacity = Capacity;
+ }
+
+ W->Tasks[W->Bottom++] = *Task;
+ pthread_mutex_unlock(&W->Lock);
+ return 1;
+}
+
+
+/*FUNCTION:*/
+static int Worker_Pop(struct Worker *W, struct Solver_Task *Task)
+{
+ /*Newest task first, it is the deepest & keeps this worker depth first*/
+
+ int Taken = 0;
+
+
+ pthread_mutex_lock(&W->Lock);
+
+ if (W->Bottom > W->Top)
+ {
+  *Task = W->Tasks[--W->Bottom];
+  Taken = 1;
+ }
+
+ if (W->Bottom == W->Top)
+   W->Top = W->Bottom = 0;
+
+ pthread_mutex_unlock(&W->Lock);
+ return Taken;
+}
+
+
+/*FUNCTION:*/
+static int Worker_Steal(struct Worker *Thief, struct Solver_Task *Task)
+{
+ /*Oldest task of another worker, it is the shallowest & so the largest*/
+
+ struct Solver *S = Thief->S;
+ struct Worker *Victim;
+ int            Offset, Taken = 0;
+
+
+ for (Offset = 1; Offset < S->Threads && !Taken; Offset++)
+ {
+  Victim = &S->Workers[(Thief - S->Workers + Offset) % S->Threads];
+
+  pthread_mutex_lock(&Victim->Lock);
+  if (Victim->Bottom > Victim->Top)
+  {
+   *Task = Victim->Tasks[Victim->Top++];
+   Taken = 1;
+  }
+  pthread_mutex_unlock(&Victim->Lock);
+ }
+
+ return Taken;
+}
+
+
+/*FUNCTION:*/
+static int Solver_Search(struct Worker *W, struct Bitboard Pegs,
+                         struct Pagoda_Sums Sums, int Depth)
+{
+ /*Returns 1 when Pegs reaches the goal, filling Line[Depth onwards] on the
+   way back up, 0 when it cannot & -1 when the search has to stop. Sums are
+   the pagoda sums of Pegs, each child gets them updated by its jump*/
+
+ struct Solver    *S = W->S;
+ struct Jump_Masks Jumps;
+ struct Bitboard   Origins;
+ uint64_t          Key;
+ int               Direction, From, Found, Beads;
+
+
+ if (++W->Nodes >= NODE_BATCH)
+   Solver_Count(W);
+
+ if (__atomic_load_n(&S->Stop, __ATOMIC_RELAXED) != STOP_NONE)
+   return -1;
+
+ Beads = Bitboard_Count(Pegs);
+ if (Beads == 1)
+   return Bitboard_Is_Won(Pegs);
+
+ if (Pagoda_Lost(Sums, Beads) || Database_Lookup(Pegs) == 0)
+   return 0;
+
+ Key = Symmetry_Canonical(Bitboard_Pack(Pegs));
+ if (Dead_Lookup(S, Key))
+   return 0;
+
+ Bitboard_Legal_Jumps(Pegs, &Jumps);
+
+ for (Direction = Jump_Up; Direction < JUMP_DIRECTIONS; Direction++)
+ {
+  Origins = Jumps.From[Direction];
+
+  while (!Bitboard_Is_Empty(Origins))
+  {
+   From  = Bitboard_Pop(&Origins);
+   Found = Solver_Search(W, Bitboard_Toggle(Pegs, From,
+                                  From + Jump_Offset[Direction],
+                                  From + 2 * Jump_Offset[Direction]),
+                         Pagoda_Jump(Sums, From, Direction), Depth + 1);
+
+   if (Found == 1)
+   {
+    W->Line[Depth].From = From;
+    W->Line[Depth].Over = From + Jump_Offset[Direction];
+    W->Line[Depth].To   = From + 2 * Jump_Offset[Direction];
+   }
+
+   if (Found != 0)
+     return Found;
+  }
+ }
+
+ Dead_Insert(S, Key);
+ return 0;
+}
+
+
+/*FUNCTION:*/
+static void Solver_Count(struct Worker *W)
+{
+ /*Adds the locally counted nodes to the shared total & enforces the limit*/
+
+ struct Solver *S = W->S;
+ uint64_t       Total;
+ int            Expected = STOP_NONE;
+
+
+ Total    = __atomic_add_fetch(&S->Nodes, W->Nodes, __ATOMIC_RELAXED);
+ W->Nodes = 0;
+
+ if (S->Node_Limit && Total > S->Node_Limit)
+   __atomic_compare_exchange_n(&S->Stop, &Expected, STOP_LIMIT, 0,
+                               __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+
+
+/*FUNCTION:*/
+static int Dead_Lookup(struct Solver *S, uint64_t Key)
+{
+ uint64_t Slot = (Key * 0x9e3779b97f4a7c15ULL) >> (64 - SOLVER_TABLE_BITS),
+          Entry;
+ int      Probe;
+
+
+ for (Probe = 0; Probe < PROBE_LENGTH; Probe++)
+ {
+  Entry = __atomic_load_n(&S->Dead[(Slot + Probe) & S->Mask], __ATOMIC_RELAXED);
+  if (Entry == Key) return 1;
+  if (Entry == 0)   return 0;
+ }
+
+ return 0;
+}
+
+
+/*FUNCTION:*/
+static void Dead_Insert(struct Solver *S, uint64_t Key)
+{
+ /*Claims the first empty slot of the run with a compare & swap, a slot taken
+   by another thread in the meantime just moves the probe on*/
+
+ uint64_t Slot = (Key * 0x9e3779b97f4a7c15ULL) >> (64 - SOLVER_TABLE_BITS),
+          Expected;
+ int      Probe;
+
+
+ for (Probe = 0; Probe < PROBE_LENGTH; Probe++)
+ {
+  Expected = 0;
+  if (__atomic_compare_exchange_n(&S->Dead[(Slot + Probe) & S->Mask],
+                                  &Expected, Key, 0,
+                                  __ATOMIC_RELAXED, __ATOMIC_RELAXED) ||
+      Expected == Key)
+    return;
+ }
+
+ /*Run is full, the first slot is replaced*/
+ __atomic_store_n(&S->Dead[Slot & S->Mask], Key, __ATOMIC_RELAXED);
+}
+
+
+/*FUNCTION:*/
+static int Longest_Search(struct Bitboard Pegs, uint64_t *Nodes_Left)
+{
+ /*Depth first over every jump, the best child + 1 is the answer. Stops early
+   once a line leaves 1 bead, nothing can be longer than that*/
+
+ struct Jump_Masks Jumps;
+ struct Bitboard   Origins;
+ const uint64_t    Mask = ((uint64_t) 1 << LONGEST_TABLE_BITS) - 1;
+ uint64_t          Key, Slot, Entry;
+ int               Direction, From, Probe, Jumped, Best = 0,
+                   Most = Bitboard_Count(Pegs) - 1;
+
+
+ if (Most <= 0)
+   return 0;
+
+ Key  = Symmetry_Canonical(Bitboard_Pack(Pegs));
+ Slot = (Key * 0x9e3779b97f4a7c15ULL) >> (64 - LONGEST_TABLE_BITS);
+
+ for (Probe = 0; Probe < PROBE_LENGTH; Probe++)
+ {
+  Entry = Longest_Table[(Slot + Probe) & Mask];
+  if ((Entry >> 6) == Key) return (int) (Entry & 63) - 1;
+  if (Entry == 0) break;
+ }
+
+ if (*Nodes_Left == 0)
+   return -1;
+ --*Nodes_Left;
+
+ Bitboard_Legal_Jumps(Pegs, &Jumps);
+
+ for (Direction = Jump_Up; Direction < JUMP_DIRECTIONS && Best < Most; Direction++)
+ {
+  Origins = Jumps.From[Direction];
+
+  while (!Bitboard_Is_Empty(Origins) && Best < Most)
+  {
+   From   = Bitboard_Pop(&Origins);
+   Jumped = Longest_Search(Bitboard_Toggle(Pegs, From,
+                                   From + Jump_Offset[Direction],
+                                   From + 2 * Jump_Offset[Direction]),
+                           Nodes_Left);
+
+   if (Jumped < 0)
+     return -1;
+
+   if (Jumped + 1 > Best)
+     Best = Jumped + 1;
+  }
+ }
+
+ /*First empty slot of the run, or the first slot when the run is full*/
+ for (Probe = 0; Probe < PROBE_LENGTH; Probe++)
+    if (Longest_Table[(Slot + Probe) & Mask] == 0)
+      break;
+
+ if (Probe == PROBE_LENGTH)
+   Probe = 0;
+
+ Longest_Table[(Slot + Probe) & Mask] = (Key << 6) | (uint64_t) (Best + 1);
+ return Best;
+}
+
+
+/*FUNCTION:*/
+static int Meet_Expand(struct Meet_Layer *Layer, struct Meet_Layer *Next,
+                       int Backward, struct Bitboard Start,
+                       uint64_t *Nodes_Left)
+{
+ /*Every child (jump) or parent (unjump) of every board of Layer into Next,
+   sorted & without repeats: Next has 1 bead less than Layer going forward,
+   1 more going backward. The pagodas leave out the forward children that
+   cannot finish & the backward parents that Start cannot reach, the
+   endgame database the forward children it knows are lost. Returns 1, 0
+   when Next is empty & -1 on the node limit or out of memory. Start is the
+   board the forward side started from.
+
+   A layer holds canonical boards & the pagodas are not symmetric, a parent
+   is kept when any image of Start can reach it*/
+
+ struct Jump_Masks  Jumps;
+ struct Bitboard    Pegs, Origins;
+ struct Pagoda_Sums Sums, Parent, Start_Sums[BOARD_SYMMETRIES];
+ size_t             Index, Kept;
+ int                Direction, From, Symmetry,
+                    Beads       = Layer->Count ? POPCOUNT64(Layer->Keys[0]) : 0,
+                    Start_Beads = Bitboard_Count(Start);
+
+
+ for (Symmetry = 0; Symmetry < BOARD_SYMMETRIES; Symmetry++)
+    Start_Sums[Symmetry] = Pagoda_Evaluate(Bitboard_Unpack(
+                           Symmetry_Transform(Symmetry, Bitboard_Pack(Start))));
+
+ for (Index = 0; Index < Layer->Count; Index++)
+ {
+  if (*Nodes_Left == 0)
+    return -1;
+  --*Nodes_Left;
+
+  Pegs = Bitboard_Unpack(Layer->Keys[Index]);
+  Sums = Pagoda_Evaluate(Pegs);
+
+  if (Backward) Bitboard_Legal_Unjumps(Pegs, &Jumps);
+  else          Bitboard_Legal_Jumps(Pegs, &Jumps);
+
+  for (Direction = Jump_Up; Direction < JUMP_DIRECTIONS; Direction++)
+  {
+   Origins = Jumps.From[Direction];
+
+   while (!Bitboard_Is_Empty(Origins))
+   {
+    From = Bitboard_Pop(&Origins);
+
+    if (Backward)
+    {
+     Parent = Pagoda_Unjump(Sums, From, Direction);
+     for (Symmetry = 0; Symmetry < BOARD_SYMMETRIES; Symmetry++)
+        if (Pagoda_Reachable(Parent, Beads + 1, Start_Sums[Symmetry],
+                             Start_Beads))
+          break;
+
+     if (Symmetry == BOARD_SYMMETRIES)
+       continue;
+    }
+    else if (Pagoda_Lost(Pagoda_Jump(Sums, From, Direction), Beads - 1))
+      continue;
+
+    if (!Layer_Add(Next, Symmetry_Canonical(Bitboard_Pack(
+                   Bitboard_Toggle(Pegs, From, From + Jump_Offset[Direction],
+                                   From + 2 * Jump_Offset[Direction])))))
+      return -1;
+   }
+  }
+ }
+
+ Layer_Sort(Next);
+
+ /*The database answers for whole layers of the forward side*/
+ if (!Backward && Beads - 1 <= Database_Max_Pegs())
+ {
+  for (Index = Kept = 0; Index < Next->Count; Index++)
+     if (Database_Lookup(Bitboard_Unpack(Next->Keys[Index])) != 0)
+       Next->Keys[Kept++] = Next->Keys[Index];
+
+  Next->Count = Kept;
+ }
+
+ return Next->Count > 0;
+}
+
+
+/*FUNCTION:*/
+static int Meet_Step(struct Bitboard *Pegs, const struct Meet_Layer *Layer,
+                     struct Solver_Jump *Jump)
+{
+ /*Makes the first jump of *Pegs that lands on a board of Layer & writes it
+   to Jump, 1 when there is one*/
+
+ struct Jump_Masks Jumps;
+ struct Bitboard   Origins, Child;
+ int               Direction, From;
+
+
+ Bitboard_Legal_Jumps(*Pegs, &Jumps);
+
+ for (Direction = Jump_Up; Direction < JUMP_DIRECTIONS; Direction++)
+ {
+  Origins = Jumps.From[Direction];
+
+  while (!Bitboard_Is_Empty(Origins))
+  {
+   From  = Bitboard_Pop(&Origins);
+   Child = Bitboard_Toggle(*Pegs, From, From + Jump_Offset[Direction],
+                           From + 2 * Jump_Offset[Direction]);
+
+   if (Layer_Find(Layer, Symmetry_Canonical(Bitboard_Pack(Child))))
+   {
+    Jump->From = From;
+    Jump->Over = From + Jump_Offset[Direction];
+    Jump->To   = From + 2 * Jump_Offset[Direction];
+    *Pegs      = Child;
+    return 1;
+   }
+  }
+ }
+
+ return 0;
+}
+
+
+/*FUNCTION:*/
+static int Layer_Add(struct Meet_Layer *Layer, uint64_t Key)
+{
+ /*Appends Key. A full array is first sorted & cleared of repeats, it only
+   grows when that frees less than half of it*/
+
+ uint64_t *Grown;
+ size_t    Capacity;
+
+
+ if (Layer->Count == Layer->Capacity)
+ {
+  Layer_Sort(Layer);
+
+  if (Layer->Count >= Layer->Capacity / 2)
+  {
+   Capacity = Layer->Capacity ? Layer->Capacity * 2 : MEET_LAYER_START;
+   Grown    = realloc(Layer->Keys, Capacity * sizeof(uint64_t));
+   if (Grown == NULL) return 0;
+
+   Layer->Keys     = Grown;
+   Layer->Capacity = Capacity;
+  }
+ }
+
+ Layer->Keys[Layer->Count++] = Key;
+ return 1;
+}
+
+
+/*FUNCTION:*/
+static void Layer_Sort(struct Meet_Layer *Layer)
+{
+ size_t Index, Kept;
+
+
+ if (Layer->Count < 2) return;
+
+ qsort(Layer->Keys, Layer->Count, sizeof(uint64_t), Key_Compare);
+
+ for (Index = Kept = 1; Index < Layer->Count; Index++)
+    if (Layer->Keys[Index] != Layer->Keys[Kept - 1])
+      Layer->Keys[Kept++] = Layer->Keys[Index];
+
+ Layer->Count = Kept;
+}
+
+
+/*FUNCTION:*/
+static int Layer_Find(const struct Meet_Layer *Layer, uint64_t Key)
+{
+ /*Binary search of a sorted layer*/
+
+ size_t Low = 0, High = Layer->Count, Middle;
+
+
+ while (Low < High)
+ {
+  Middle = Low + (High - Low) / 2;
+
+  if (Layer->Keys[Middle] < Key) Low  = Middle + 1;
+  else                          High = Middle;
+ }
+
+ return Low < Layer->Count && Layer->Keys[Low] == Key;
+}
+
+
+/*FUNCTION:*/
+static int Key_Compare(const void *A, const void *B)
+{
+ uint64_t Left = *(const uint64_t *) A, Right = *(const uint64_t *) B;
+
+
+ return (Left > Right) - (Left < Right);
+}
@@ -0,0 +1,55 @@
+/*Date:    17Oct2026Sat 10:05
+//File:    peg_solver.h
+//Desc:    Exhaustive depth first solver for the 9x9 cross board. Answers "can
+           this position still finish with 1 bead on board[4][4] & how?".
+           Positions proven dead are remembered in a hashed transposition
+           table so a position reached by 2 different jump orders is only
+           searched once. The search can be spread over several threads which
+           share that table, link with -pthread. The table outlives a
+           search, Solver_Free releases it. Solver_Meet answers the same
+           question by searching from both ends at once, forward from the
+           position & backward from the finish, until the 2 sides meet.
+*/
+
+
+#ifndef PEG_SOLVER_H
+#define PEG_SOLVER_H
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include "peg_engine.h"
+
+#define SOLVER_TABLE_BITS 22 /*2^22 dead positions, 32MB*/
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+/*1 jump of a solution as bit indices, see HOLE_INDEX*/
+struct Solver_Jump
+{
+ unsigned char From, Over, To;
+};
+
+struct Solver_Result
+{
+ int                Solvable;  /*1 yes, 0 no, -1 search gave up*/
+ int                Moves;     /*number of jumps in Solution*/
+ struct Solver_Jump Solution[BOARD_HOLES];
+ uint64_t           Nodes;     /*positions visited*/
+};
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+int  Solver_Solve(struct Bitboard Pegs, int Threads, uint64_t Node_Limit,
+                  struct Solver_Result *Result);
+int  Solver_Meet(struct Bitboard Pegs, int Meet_Pegs, uint64_t Node_Limit,
+                 struct Solver_Result *Result);
+int  Solver_Longest(struct Bitboard Pegs, uint64_t Node_Limit);
+void Solver_Free(void);
+
+#endif
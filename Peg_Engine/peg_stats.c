@@ -0,0 +1,240 @@
+/*Date:    17Oct2026Sat 20:50
+//File:    peg_stats.c
+//Desc:    Stage timers & the report of peg_stats.h. A sample costs 2 reads
+           of the clock & a few adds, the bucket is the position of its
+           highest bit.
+*/
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#define _POSIX_C_SOURCE 200809L /*sigaction with SA_RESTART, clock_gettime*/
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+#include "peg_stats.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>
+#define STATS_TSC
+#define STATS_UNIT "cycles"
+#else
+#define STATS_UNIT "ns"
+#endif
+
+#define STATS_BAR 40 /*characters of the longest histogram bar*/
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+/*A stage being timed*/
+struct Stats_Frame
+{
+ enum Stats_Stage Stage;
+ int              Nested;   /*begun again inside itself*/
+ uint64_t         Start,
+                  Children; /*time of the stages begun inside it*/
+};
+
+
+/*----------------------------
+//Global Variable Declarations
+----------------------------*/
+static struct Stats_Counter Stats_Counter[Stats_Stages];
+static struct Stats_Frame   Stats_Stack[STATS_DEPTH];
+static int                  Stats_Depth = 0;
+
+static volatile sig_atomic_t Stats_Requested = 0; /*set by SIGUSR1*/
+
+static const char *Stats_Name[Stats_Stages] =
+{
+ "input", "dispatch", "rules", "compose", "output"
+};
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+static void Stats_Signal_Handler(int Signal);
+
+
+/*--------------------
+//Function Definitions (Implementation)
+--------------------*/
+
+
+/*FUNCTION:*/
+void Stats_Init(void)
+{
+ /*The report is only asked for by the signal, it is written by Stats_Poll
+   from the main loop as stdio is not safe in a handler. Without SA_RESTART
+   a read waiting for input fails with EINTR, the front ends poll then &
+   read again, so the report does not wait for the next key*/
+
+ struct sigaction Request;
+ int              Stage;
+
+
+ for (Stage = 0; Stage < Stats_Stages; Stage++)
+ {
+  memset(&Stats_Counter[Stage], 0, sizeof(Stats_Counter[Stage]));
+  Stats_Counter[Stage].Min = UINT64_MAX;
+ }
+
+ memset(&Request, 0, sizeof(Request));
+ Request.sa_handler = Stats_Signal_Handler;
+ Request.sa_flags   = 0;
+ sigemptyset(&Request.sa_mask);
+ sigaction(SIGUSR1, &Request, NULL);
+}
+
+
+/*FUNCTION:*/
+uint64_t Stats_Clock(void)
+{
+#ifdef STATS_TSC
+ return __rdtsc();
+#else
+ struct timespec Now;
+
+
+ clock_gettime(CLOCK_MONOTONIC, &Now);
+ return (uint64_t) Now.tv_sec * 1000000000 + Now.tv_nsec;
+#endif
+}
+
+
+/*FUNCTION:*/
+void Stats_Begin(enum Stats_Stage Stage)
+{
+ struct Stats_Frame *Frame;
+
+
+ if (Stats_Depth > 0 && Stats_Stack[Stats_Depth - 1].Stage == Stage)
+ {
+  Stats_Stack[Stats_Depth - 1].Nested++;
+  return;
+ }
+
+ /*Too deep: counted as open so the ends still pair up, but not timed*/
+ if (Stats_Depth++ >= STATS_DEPTH) return;
+
+ Frame           = &Stats_Stack[Stats_Depth - 1];
+ Frame->Stage    = Stage;
+ Frame->Nested   = 0;
+ Frame->Children = 0;
+ Frame->Start    = Stats_Clock();
+}
+
+
+/*FUNCTION:*/
+void Stats_End(enum Stats_Stage Stage)
+{
+ struct Stats_Counter *Counter;
+ struct Stats_Frame   *Frame;
+ uint64_t              Elapsed, Sample;
+ int                   Bucket = 0;
+
+
+ if (Stats_Depth == 0) return;
+ if (Stats_Depth > STATS_DEPTH)
+ {
+  Stats_Depth--;
+  return;
+ }
+
+ Frame = &Stats_Stack[Stats_Depth - 1];
+ if (Frame->Stage == Stage && Frame->Nested > 0)
+ {
+  Frame->Nested--;
+  return;
+ }
+
+ Elapsed = Stats_Clock() - Frame->Start;
+ Sample  = Elapsed - Frame->Children;
+ if (--Stats_Depth > 0) Stats_Stack[Stats_Depth - 1].Children += Elapsed;
+
+ Counter = &Stats_Counter[Frame->Stage];
+ Counter->Calls++;
+ Counter->Total += Sample;
+ if (Sample < Counter->Min) Counter->Min = Sample;
+ if (Sample > Counter->Max) Counter->Max = Sample;
+
+ while (Sample >>= 1) Bucket++;
+ Counter->Bucket[Bucket < STATS_BUCKETS ? Bucket : STATS_BUCKETS - 1]++;
+}
+
+
+/*FUNCTION:*/
+void Stats_Poll(void)
+{
+ if (!Stats_Requested) return;
+
+ Stats_Requested = 0;
+ Stats_Report(stderr);
+}
+
+
+/*FUNCTION:*/
+void Stats_Report(FILE *Stream)
+{
+ /*1 line per stage, then the histogram of every stage that ran: the range
+   of a bucket, its samples & a bar scaled to the fullest bucket*/
+
+ const struct Stats_Counter *Counter;
+ uint64_t                    Fullest;
+ int                         Stage, Bucket, Bar;
+
+
+ fprintf(Stream, "%-10s %10s %14s %12s %12s %12s  (%s)\n", "stage", "calls",
+         "total", "mean", "min", "max", STATS_UNIT);
+
+ for (Stage = 0; Stage < Stats_Stages; Stage++)
+ {
+  Counter = &Stats_Counter[Stage];
+  fprintf(Stream, "%-10s %10llu %14llu %12llu %12llu %12llu\n",
+          Stats_Name[Stage], (unsigned long long) Counter->Calls,
+          (unsigned long long) Counter->Total,
+          (unsigned long long) (Counter->Calls ?
+                                Counter->Total / Counter->Calls : 0),
+          (unsigned long long) (Counter->Calls ? Counter->Min : 0),
+          (unsigned long long) Counter->Max);
+ }
+
+ for (Stage = 0; Stage < Stats_Stages; Stage++)
+ {
+  Counter = &Stats_Counter[Stage];
+  if (Counter->Calls == 0) continue;
+
+  for (Fullest = 0, Bucket = 0; Bucket < STATS_BUCKETS; Bucket++)
+     if (Counter->Bucket[Bucket] > Fullest) Fullest = Counter->Bucket[Bucket];
+
+  fprintf(Stream, "\n%s\n", Stats_Name[Stage]);
+  for (Bucket = 0; Bucket < STATS_BUCKETS; Bucket++)
+  {
+   if (Counter->Bucket[Bucket] == 0) continue;
+
+   fprintf(Stream, " %12llu - %-12llu %10llu ",
+           (unsigned long long) (Bucket ? 1ULL << Bucket : 0),
+           (unsigned long long) ((2ULL << Bucket) - 1),
+           (unsigned long long) Counter->Bucket[Bucket]);
+   for (Bar = (int) ((Counter->Bucket[Bucket] * STATS_BAR + Fullest - 1) /
+                     Fullest); Bar > 0; Bar--)
+      fputc('#', Stream);
+   fputc('\n', Stream);
+  }
+ }
+
+ fflush(Stream);
+}
+
+
+/*FUNCTION:*/
+static void Stats_Signal_Handler(int Signal)
+{
+ (void) Signal;
+ Stats_Requested = 1;
+}
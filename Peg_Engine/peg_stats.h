@@ -0,0 +1,83 @@
+/*Date:    17Oct2026Sat 20:50
+//File:    peg_stats.h
+//Desc:    Counters & cycle timers around the stages of a front end's main
+           loop, for seeing where the time of a slow session goes without a
+           profiler. Built in only with -DPEG_STATS, otherwise the STATS_
+           macros are empty & the front ends do not need peg_stats.c.
+
+           A stage is timed between STATS_BEGIN & STATS_END. Stages nest: the
+           time of a stage begun inside another is taken off the outer one,
+           so every cycle is counted once, in the innermost stage running. A
+           stage begun again inside itself (Board_Cursor drawing the status
+           window) is folded into the outer sample.
+
+           Per stage the report has calls, total, mean, min & max & a
+           histogram of the samples in powers of 2. The unit is the time
+           stamp counter on x86 & nanoseconds elsewhere. It is written to
+           stderr on quit & by STATS_POLL after SIGUSR1, from the main loop
+           or from the input wait it cuts short, so an idle game reports at
+           once. Not while a solve or a count runs, that is after it:
+            ./peg_solitaire 2>stats & kill -USR1 <pid>
+
+           Not thread safe, the stages are all on the thread of the UI.
+*/
+
+
+#ifndef PEG_STATS_H
+#define PEG_STATS_H
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#include <stdint.h>
+#include <stdio.h>
+
+#define STATS_BUCKETS 48 /*samples of 2^n to 2^(n+1) - 1 in bucket n*/
+#define STATS_DEPTH   8  /*stages open at once*/
+
+#ifdef PEG_STATS
+#define STATS_INIT()       Stats_Init()
+#define STATS_BEGIN(Stage) Stats_Begin(Stage)
+#define STATS_END(Stage)   Stats_End(Stage)
+#define STATS_POLL()       Stats_Poll()
+#define STATS_REPORT()     Stats_Report(stderr)
+#else
+#define STATS_INIT()       ((void) 0)
+#define STATS_BEGIN(Stage) ((void) 0)
+#define STATS_END(Stage)   ((void) 0)
+#define STATS_POLL()       ((void) 0)
+#define STATS_REPORT()     ((void) 0)
+#endif
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+/*Input: waiting for & reading a key or line. Dispatch: acting on it. Rules:
+  validating a jump & testing for the end of the game. Compose: drawing into
+  the screen buffer or windows. Output: sending the frame to the terminal*/
+enum Stats_Stage {Stats_Input, Stats_Dispatch, Stats_Rules, Stats_Compose,
+                  Stats_Output, Stats_Stages};
+
+struct Stats_Counter
+{
+ uint64_t Calls,
+          Total,
+          Min,
+          Max,
+          Bucket[STATS_BUCKETS];
+};
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+void     Stats_Init(void);
+uint64_t Stats_Clock(void);
+void     Stats_Begin(enum Stats_Stage Stage);
+void     Stats_End(enum Stats_Stage Stage);
+void     Stats_Poll(void);
+void     Stats_Report(FILE *Stream);
+
+#endif
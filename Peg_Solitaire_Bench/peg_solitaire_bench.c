@@ -0,0 +1,569 @@
+/*Date:    18Oct2026Sun 01:40
+//File:    peg_solitaire_bench.c
+//Desc:    Microbenchmarks of the stdio front end & the engine under it, 4
+           areas with 1 or 2 benchmarks each:
+
+            rules        bead_manager   Bead_Manager making 1 jump on a
+                                        board of the corpus
+                         stale_mate     the tests of Stale_Mate_Checker,
+                                        Game_Is_Won & Game_Is_Stalemate
+            frame        board_frame    Peg_Solitaire_Board & Display_Screen
+                                        of the next board of the corpus
+            command      command_token  Command_Token, the parser of
+                                        Command_Line, on 1 line
+                         command_line   Command_Line reading, parsing &
+                                        running 1 line
+            persistence  save_load      Save_Game & Load_Game, 1 round trip
+
+           The front end is compiled into this program (its main renamed),
+           so the functions timed are the ones the game runs. The corpus is
+           --corpus boards of 16 to 28 beads from random games, each with a
+           legal jump selected.
+
+           Every benchmark first doubles its operations per repetition until
+           1 takes --min-time ms, runs --warmup repetitions that are not
+           kept & then --repetitions that are. The result is the median &
+           the median absolute deviation (MAD) of ns per operation over those
+           & the allocations per operation: malloc, calloc & realloc are
+           wrapped to count calls, those inside the C library (fopen) too.
+           --json writes 1 JSON object instead of the table, for trend
+           tracking.
+
+           Display_Screen writes the frame to standard output, which is
+           /dev/null while the benchmarks run, the results go to the real
+           one. Save_Game & Load_Game work in a temporary directory.
+
+
+           To compile with gcc command:
+            gcc -Wall -Werror -Wextra -Wunused -O2 -pthread peg_solitaire_bench.c ../Peg_Engine/peg_engine.c ../Peg_Engine/peg_command.c ../Peg_Engine/peg_game.c ../Peg_Engine/peg_solver.c ../Peg_Engine/peg_database.c ../Peg_Engine/peg_rank.c ../Peg_Engine/peg_pagoda.c ../Peg_Engine/peg_save.c ../Peg_Engine/peg_journal.c ../Peg_Engine/peg_large.c ../Peg_Engine/peg_count.c -o peg_solitaire_bench
+           To run: ./peg_solitaire_bench --json > bench.json
+           Options: --repetitions N  kept repetitions (default 15)
+                    --warmup N       repetitions run first & dropped
+                                     (default 3)
+                    --min-time MS    least time of 1 repetition (default 10)
+                    --corpus N       boards in the corpus (default 256)
+                    --seed N         random games seed (default 1)
+                    --json           JSON output
+
+           Output fields: name, area, repetitions, ops_per_repetition,
+           ns_per_op median mad min max, allocations_per_op.
+
+           The allocation counter replaces malloc of glibc through its
+           __libc_malloc entry points, other C libraries need another way.
+*/
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#define main Peg_Solitaire_Main
+#include "../peg_solitaire.c"
+#undef main
+
+#include <fcntl.h>
+#include <time.h>
+
+#define BENCH_CORPUS_MAX 4096
+#define BENCH_REPS_MAX   1000
+#define BENCH_MIN_BEADS  16
+#define BENCH_MAX_BEADS  28
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+struct Bench
+{
+ const char *Name,
+            *Area;
+ void      (*Run)(unsigned long Ops);
+};
+
+struct Bench_Result
+{
+ unsigned long Ops;        /*per repetition*/
+ double        Median,     /*ns per operation*/
+               MAD,
+               Min,
+               Max,
+               Allocations; /*per operation*/
+};
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+void    *__libc_malloc(size_t Size);
+void    *__libc_calloc(size_t Count, size_t Size);
+void    *__libc_realloc(void *Block, size_t Size);
+void     __libc_free(void *Block);
+
+uint64_t Bench_Now(void);
+uint64_t Bench_Random(void);
+void     Bench_Corpus(int Boards);
+void     Bench_Screen(void);
+void     Bench_Measure(const struct Bench *Test, struct Bench_Result *Result);
+double   Bench_Median(double *Values, int Count);
+int      Bench_Compare(const void *A, const void *B);
+void     Bench_Bead_Manager(unsigned long Ops);
+void     Bench_Stale_Mate(unsigned long Ops);
+void     Bench_Board_Frame(unsigned long Ops);
+void     Bench_Command_Token(unsigned long Ops);
+void     Bench_Command_Line(unsigned long Ops);
+void     Bench_Save_Load(unsigned long Ops);
+
+
+/*----------------------------
+//Global Variable Declarations
+----------------------------*/
+const struct Bench Benches[] =
+{
+ {"bead_manager",  "rules",       Bench_Bead_Manager},
+ {"stale_mate",    "rules",       Bench_Stale_Mate},
+ {"board_frame",   "frame",       Bench_Board_Frame},
+ {"command_token", "command",     Bench_Command_Token},
+ {"command_line",  "command",     Bench_Command_Line},
+ {"save_load",     "persistence", Bench_Save_Load}
+};
+
+/*Typed lines of a session: commands, aliases & typos. Nothing that
+  searches (solve, count) or touches a file (save, load)*/
+const char *Bench_Lines[] =
+{
+ "up", "down", "left", "right", "k", "j", "h", "l", "tab", "help", "?",
+ "main", "menu", "info", "settings", "new", "uo", "dwon", "helpme",
+ "instructionsxx", "xyzzy", "1", "select"
+};
+
+#define BENCH_LINES ((int) (sizeof(Bench_Lines) / sizeof(Bench_Lines[0])))
+
+struct Peg_Game Corpus[BENCH_CORPUS_MAX];
+int             Corpus_Boards = 256,
+                Corpus_Next   = 0;
+
+unsigned long   Bench_Allocations = 0;
+uint64_t        Random_State      = 1;
+int             Repetitions = 15,
+                Warmup      = 3,
+                Min_Time_Ms = 10;
+
+
+/*------------
+//Main Program
+------------*/
+int main(int argc, char *argv[])
+{
+ struct Bench_Result Results[sizeof(Benches) / sizeof(Benches[0])];
+ char                Directory[] = "/tmp/peg_solitaire_bench.XXXXXX";
+ FILE               *Out;
+ int                 Arg, Index, Json = 0, Null_Fd,
+                     Count = (int) (sizeof(Benches) / sizeof(Benches[0]));
+
+
+ for (Arg = 1; Arg < argc; Arg++)
+ {
+  if (strcmp(argv[Arg], "--repetitions") == 0 && Arg + 1 < argc)
+    Repetitions = atoi(argv[++Arg]);
+  else if (strcmp(argv[Arg], "--warmup") == 0 && Arg + 1 < argc)
+    Warmup = atoi(argv[++Arg]);
+  else if (strcmp(argv[Arg], "--min-time") == 0 && Arg + 1 < argc)
+    Min_Time_Ms = atoi(argv[++Arg]);
+  else if (strcmp(argv[Arg], "--corpus") == 0 && Arg + 1 < argc)
+    Corpus_Boards = atoi(argv[++Arg]);
+  else if (strcmp(argv[Arg], "--seed") == 0 && Arg + 1 < argc)
+    Random_State = strtoull(argv[++Arg], NULL, 10);
+  else if (strcmp(argv[Arg], "--json") == 0)
+    Json = 1;
+  else
+  {
+   printf("Usage: %s [--repetitions N] [--warmup N] [--min-time MS] "
+          "[--corpus N] [--seed N] [--json]\n", argv[0]);
+   return EXIT_FAILURE;
+  }
+ }
+
+ if (Repetitions < 1) Repetitions = 1;
+ if (Repetitions > BENCH_REPS_MAX) Repetitions = BENCH_REPS_MAX;
+ if (Warmup < 0) Warmup = 0;
+ if (Min_Time_Ms < 1) Min_Time_Ms = 1;
+ if (Corpus_Boards < 1) Corpus_Boards = 1;
+ if (Corpus_Boards > BENCH_CORPUS_MAX) Corpus_Boards = BENCH_CORPUS_MAX;
+ if (Random_State == 0) Random_State = 1;
+
+ /*Results on the real standard output, the frames of Display_Screen &
+   the prompts of Command_Line in /dev/null*/
+ Out     = fdopen(dup(STDOUT_FILENO), "w");
+ Null_Fd = open("/dev/null", O_WRONLY);
+ if (Out == NULL || Null_Fd < 0 || mkdtemp(Directory) == NULL ||
+     chdir(Directory) != 0)
+ {
+  perror("peg_solitaire_bench");
+  return EXIT_FAILURE;
+ }
+ fflush(stdout);
+ dup2(Null_Fd, STDOUT_FILENO);
+ close(Null_Fd);
+
+ Bench_Corpus(Corpus_Boards);
+ Bench_Screen();
+
+ for (Index = 0; Index < Count; Index++)
+    Bench_Measure(&Benches[Index], &Results[Index]);
+
+ remove("peg_solitaire.save");
+ remove("commands.txt");
+ if (chdir("/") == 0) rmdir(Directory);
+
+ if (Json)
+ {
+  fprintf(Out, "{\"repetitions\": %d, \"warmup\": %d, \"min_time_ms\": %d, "
+               "\"corpus\": %d, \"benchmarks\": [",
+          Repetitions, Warmup, Min_Time_Ms, Corpus_Boards);
+
+  for (Index = 0; Index < Count; Index++)
+     fprintf(Out, "%s{\"name\": \"%s\", \"area\": \"%s\", "
+                  "\"repetitions\": %d, \"ops_per_repetition\": %lu, "
+                  "\"ns_per_op\": {\"median\": %.1f, \"mad\": %.1f, "
+                  "\"min\": %.1f, \"max\": %.1f}, "
+                  "\"allocations_per_op\": %.3f}",
+             Index ? ", " : "", Benches[Index].Name, Benches[Index].Area,
+             Repetitions, Results[Index].Ops, Results[Index].Median,
+             Results[Index].MAD, Results[Index].Min, Results[Index].Max,
+             Results[Index].Allocations);
+
+  fprintf(Out, "]}\n");
+ }
+ else
+ {
+  fprintf(Out, "%-14s %-12s %12s %12s %10s %10s\n", "benchmark", "area",
+          "ops/rep", "median ns", "mad ns", "allocs/op");
+
+  for (Index = 0; Index < Count; Index++)
+     fprintf(Out, "%-14s %-12s %12lu %12.1f %10.1f %10.3f\n",
+             Benches[Index].Name, Benches[Index].Area, Results[Index].Ops,
+             Results[Index].Median, Results[Index].MAD,
+             Results[Index].Allocations);
+ }
+
+ return fclose(Out) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+/*--------------------
+//Function Definitions (Implementation)
+--------------------*/
+
+
+/*FUNCTION:*/
+void *malloc(size_t Size)
+{
+ /*The allocation counter, the block comes from glibc as before*/
+
+ Bench_Allocations++;
+ return __libc_malloc(Size);
+}
+
+
+/*FUNCTION:*/
+void *calloc(size_t Count, size_t Size)
+{
+ Bench_Allocations++;
+ return __libc_calloc(Count, Size);
+}
+
+
+/*FUNCTION:*/
+void *realloc(void *Block, size_t Size)
+{
+ Bench_Allocations++;
+ return __libc_realloc(Block, Size);
+}
+
+
+/*FUNCTION:*/
+void free(void *Block)
+{
+ __libc_free(Block);
+}
+
+
+/*FUNCTION:*/
+uint64_t Bench_Now(void)
+{
+ struct timespec Time;
+
+
+ clock_gettime(CLOCK_MONOTONIC, &Time);
+ return (uint64_t) Time.tv_sec * 1000000000ULL + (uint64_t) Time.tv_nsec;
+}
+
+
+/*FUNCTION:*/
+uint64_t Bench_Random(void)
+{
+ /*xorshift64, the corpus is the same for the same --seed*/
+
+ Random_State ^= Random_State << 13;
+ Random_State ^= Random_State >> 7;
+ Random_State ^= Random_State << 17;
+ return Random_State;
+}
+
+
+/*FUNCTION:*/
+void Bench_Corpus(int Boards)
+{
+ /*Random games from the start, each stopped at a bead count from
+   BENCH_MIN_BEADS to BENCH_MAX_BEADS with a legal jump left. That jump is
+   selected: the bead on Selected & the cursor on the hole it lands on*/
+
+ struct Peg_Game *Board;
+ unsigned char    Moves[JUMP_COUNT];
+ int              Index = 0, Stop, Count;
+
+
+ while (Index < Boards)
+ {
+  Board = &Corpus[Index];
+  Game_Init(Board);
+  Stop  = BENCH_MIN_BEADS +
+          (int) (Bench_Random() % (BENCH_MAX_BEADS - BENCH_MIN_BEADS + 1));
+  if (Stop > Board->Beads) Stop = Board->Beads;
+
+  while ((Count = Game_Legal_Moves(Board, Moves)) > 0 && Board->Beads > Stop)
+  {
+   Count = Moves[Bench_Random() % Count];
+   Game_Apply(Board, Jump_Table[Count].From, Jump_Table[Count].To);
+  }
+
+  if ((Count = Game_Legal_Moves(Board, Moves)) == 0)
+    continue;
+
+  Count               = Moves[Bench_Random() % Count];
+  Board->Selected_Row = Jump_Table[Count].From / BOARD_STRIDE;
+  Board->Selected_Col = Jump_Table[Count].From % BOARD_STRIDE;
+  Board->Cursor_Row   = Jump_Table[Count].To / BOARD_STRIDE;
+  Board->Cursor_Col   = Jump_Table[Count].To % BOARD_STRIDE;
+  Index++;
+ }
+}
+
+
+/*FUNCTION:*/
+void Bench_Screen(void)
+{
+ /*The screen of a terminal with room below it, as main of the front end
+   draws it first. Display_Screen then sends only what changed*/
+
+ Screen_Rows = 24;
+ Screen_Cols = 66;
+ Term_Rows   = Screen_Rows + 1;
+ Term_Is_Tty = 1;
+
+ Board_Initialization();
+ ScreenBorderSetup();
+ Status_Window();
+ MainMenu(HighlightedMenuOption);
+ Peg_Solitaire_Board();
+ Board_Cursor();
+ Info_Window(0);
+ Display_Screen();
+}
+
+
+/*FUNCTION:*/
+void Bench_Measure(const struct Bench *Test, struct Bench_Result *Result)
+{
+ /*Ops per repetition doubled until 1 repetition takes Min_Time_Ms, then
+   Warmup repetitions dropped & Repetitions kept*/
+
+ static double Values[BENCH_REPS_MAX], Deviations[BENCH_REPS_MAX];
+ unsigned long Allocations;
+ uint64_t      Start, Time;
+ int           Rep;
+
+
+ for (Result->Ops = 1; ; Result->Ops *= 2)
+ {
+  Start = Bench_Now();
+  Test->Run(Result->Ops);
+  if (Bench_Now() - Start >= (uint64_t) Min_Time_Ms * 1000000 ||
+      Result->Ops >= (1UL << 30))
+    break;
+ }
+
+ for (Rep = 0; Rep < Warmup; Rep++)
+    Test->Run(Result->Ops);
+
+ Allocations = Bench_Allocations;
+
+ for (Rep = 0; Rep < Repetitions; Rep++)
+ {
+  Start       = Bench_Now();
+  Test->Run(Result->Ops);
+  Time        = Bench_Now() - Start;
+  Values[Rep] = (double) Time / Result->Ops;
+ }
+
+ Result->Allocations = (double) (Bench_Allocations - Allocations) /
+                       ((double) Result->Ops * Repetitions);
+
+ Result->Median = Bench_Median(Values, Repetitions);
+ Result->Min    = Values[0];
+ Result->Max    = Values[Repetitions - 1];
+
+ for (Rep = 0; Rep < Repetitions; Rep++)
+    Deviations[Rep] = Values[Rep] > Result->Median
+                      ? Values[Rep] - Result->Median
+                      : Result->Median - Values[Rep];
+ Result->MAD = Bench_Median(Deviations, Repetitions);
+}
+
+
+/*FUNCTION:*/
+double Bench_Median(double *Values, int Count)
+{
+ /*Sorts Values & returns the middle one, the mean of the 2 middle ones for
+   an even Count*/
+
+ qsort(Values, Count, sizeof(double), Bench_Compare);
+
+ if (Count % 2) return Values[Count / 2];
+ return (Values[Count / 2 - 1] + Values[Count / 2]) / 2;
+}
+
+
+/*FUNCTION:*/
+int Bench_Compare(const void *A, const void *B)
+{
+ double Left  = *(const double *) A,
+        Right = *(const double *) B;
+
+
+ return (Left > Right) - (Left < Right);
+}
+
+
+/*FUNCTION:*/
+void Bench_Bead_Manager(unsigned long Ops)
+{
+ /*The copy of the corpus game is timed too, it is 1 small struct*/
+
+ unsigned long Op;
+
+
+ for (Op = 0; Op < Ops; Op++)
+ {
+  Game = Corpus[Corpus_Next];
+  if (++Corpus_Next == Corpus_Boards) Corpus_Next = 0;
+
+  Bead_Manager();
+ }
+}
+
+
+/*FUNCTION:*/
+void Bench_Stale_Mate(unsigned long Ops)
+{
+ /*Stale_Mate_Checker of the ncurses front end without its window*/
+
+ unsigned long Op;
+ volatile int  Over = 0;
+
+
+ for (Op = 0; Op < Ops; Op++)
+ {
+  Over += Game_Is_Won(&Corpus[Corpus_Next]) ||
+          Game_Is_Stalemate(&Corpus[Corpus_Next]);
+  if (++Corpus_Next == Corpus_Boards) Corpus_Next = 0;
+ }
+}
+
+
+/*FUNCTION:*/
+void Bench_Board_Frame(unsigned long Ops)
+{
+ unsigned long Op;
+
+
+ for (Op = 0; Op < Ops; Op++)
+ {
+  Game = Corpus[Corpus_Next];
+  if (++Corpus_Next == Corpus_Boards) Corpus_Next = 0;
+
+  Peg_Solitaire_Board();
+  Display_Screen();
+ }
+}
+
+
+/*FUNCTION:*/
+void Bench_Command_Token(unsigned long Ops)
+{
+ static int    Line = 0;
+ unsigned long Op;
+ volatile int  Tokens = 0;
+
+
+ for (Op = 0; Op < Ops; Op++)
+ {
+  Tokens += Command_Token(Bench_Lines[Line], strlen(Bench_Lines[Line]));
+  if (++Line == BENCH_LINES) Line = 0;
+ }
+}
+
+
+/*FUNCTION:*/
+void Bench_Command_Line(unsigned long Ops)
+{
+ /*Standard input is a file of the lines of Bench_Lines, read again from
+   the top before it runs out*/
+
+ static int    Lines = -1;
+ FILE         *Input_File;
+ unsigned long Op;
+ int           Line;
+
+
+ if (Lines < 0)
+ {
+  if ((Input_File = fopen("commands.txt", "w")) == NULL)
+    return;
+  for (Line = 0; Line < BENCH_LINES; Line++)
+     fprintf(Input_File, "%s\n", Bench_Lines[Line]);
+  fclose(Input_File);
+
+  if (freopen("commands.txt", "r", stdin) == NULL)
+    return;
+  Lines = 0;
+ }
+
+ for (Op = 0; Op < Ops; Op++)
+ {
+  if (Lines == BENCH_LINES)
+  {
+   rewind(stdin);
+   Lines = 0;
+  }
+
+  Command_Line();
+  Lines++;
+ }
+}
+
+
+/*FUNCTION:*/
+void Bench_Save_Load(unsigned long Ops)
+{
+ unsigned long Op;
+
+
+ for (Op = 0; Op < Ops; Op++)
+ {
+  Game = Corpus[Corpus_Next];
+  if (++Corpus_Next == Corpus_Boards) Corpus_Next = 0;
+
+  Save_Game();
+  Load_Game();
+ }
+}
@@ -1,5 +1,5 @@
 /*Date:    29May2013Wed 16:50
-//Updated: 14Nov2024Thu 15:19:52
+//Updated: 18Oct2026Sun 02:01:37
 //File:    peg_solitaire_ncurses.c
 //Author:  Ashraf
 //Email:   ashraf.allie01@gmail.com
@@ -17,22 +17,53 @@
 
 
            To compile with gcc command:
-            gcc -Wall -Werror -Wextra -Wunused -pedantic `ncursesw6-config --cflags` peg_solitaire_ncurses.c `ncursesw6-config --libs` -o peg_solitaire_ncurses
+            gcc -Wall -Werror -Wextra -Wunused -pedantic `ncursesw6-config --cflags` peg_solitaire_ncurses.c ../Peg_Engine/peg_engine.c ../Peg_Engine/peg_game.c ../Peg_Engine/peg_save.c ../Peg_Engine/peg_journal.c `ncursesw6-config --libs` -o peg_solitaire_ncurses
+           or against the engine library (see ../Peg_Engine/peg_game.h):
+            gcc -Wall -Werror -Wextra -Wunused -pedantic `ncursesw6-config --cflags` peg_solitaire_ncurses.c -L../Peg_Engine -lpeg_engine `ncursesw6-config --libs` -o peg_solitaire_ncurses
            To run: ./peg_solitaire_ncurses
+           Options: --record FILE  journals every key & mouse event to FILE
+                    --replay FILE  plays the journal FILE again without
+                                   painting & checks the board it ends on
+                    --pace         with --replay, paints & keeps the pace of
+                                   the recording
+           see ../Peg_Engine/peg_journal.h
+           Add -DPEG_LATENCY to print the input to paint latency of the
+           session to stderr on quit, e.g. ./peg_solitaire_ncurses 2>latency
+           Add -DPEG_STATS ../Peg_Engine/peg_stats.c for timers around getch,
+           ChoiceSelection, the rules, window drawing & doupdate, reported
+           the same way on quit & on SIGUSR1, see ../Peg_Engine/peg_stats.h
 */
 
 
 /*----------------
 //Macro Defintions
 ----------------*/
+#include <errno.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ncurses.h>
+#ifdef PEG_LATENCY
+#include <time.h>
+#endif
+#include "../Peg_Engine/peg_engine.h"
+#include "../Peg_Engine/peg_game.h"
+#include "../Peg_Engine/peg_save.h"
+#include "../Peg_Engine/peg_stats.h"
+#include "../Peg_Engine/peg_journal.h"
 
 #define ESCAPE_KEY 27
 #define ENTER_KEY  13
 #define TAB_KEY     9
 
+/*Subwindows drawn into since the last Frame_Flush*/
+#define DIRTY_MAIN   1
+#define DIRTY_MENU   2
+#define DIRTY_INFO   4
+#define DIRTY_STATUS 8
+
+#define FRAME_COALESCE_MAX 32 /*keys handled at most before a paint is forced*/
+
 
 /*-------------------------
 //Data Structure Defintions (struct, enum union)
@@ -45,17 +76,32 @@ enum SubWindowType {Main, Menu, Info};
 ----------------------------*/
 WINDOW *MainSubWin, *MenuSubWin, *InfoSubWin, *StatusSubWin;
 
-int board[9][9],
-    beads,
-    Current_Board_Row,
-    Current_Board_Col,
-    Selected_Bead_Row,
-    Selected_Bead_Col,
-    Screen_Rows,
+struct Peg_Game Game; /*board, cursor, selection & undo log, see peg_game.h*/
+
+int Screen_Rows,
     Screen_Cols,
     HighlightedMenuOption = 1,
     Valid_Bead_Hop = 0;
 
+unsigned char Dirty_Windows = 0; /*DIRTY_ bits, painted by Frame_Flush*/
+
+struct Peg_Journal Journal;   /*--record or --replay, see
+                                ../Peg_Engine/peg_journal.h*/
+int                Recording    = 0,
+                   Replaying    = 0,
+                   Replay_Paced = 0; /*--pace, else no painting*/
+
+#ifdef NCURSES_MOUSE_VERSION
+MEVENT Mouse_Event; /*of the last KEY_MOUSE read by Key_Read*/
+#endif
+
+#ifdef PEG_LATENCY
+struct timespec Input_Time;          /*first key of the burst being handled*/
+long            Latency_Keys   = 0,
+                Latency_Frames = 0;
+double          Latency_Total  = 0,  /*microseconds*/
+                Latency_Max    = 0;
+#endif
 
 enum SubWindowType CurrentSubWindow = Main;
 
@@ -74,23 +120,71 @@ void Peg_Solitaire_Board(void);
 void Status_Window(void);
 void Info_Window(unsigned char Msg);
 void ChoiceSelection(void);
+int  Key_Read(void);
+int  Input_Pending(void);
+void Frame_Flush(void);
 void Board_Cursor_Clear(void);
 void Board_Cursor(void);
 void Bead_Manager(void);
 void Stale_Mate_Checker(void);
+void Undo_Jump(void);
+void Redo_Jump(void);
 void Save_Game(void);
 void Load_Game(void);
 void DestroySubWindows(void);
 void Ncurses_End(void);
+int  Replay_Verify(uint64_t Started);
 
 
 /*------------
 //Main Program
 ------------*/
-int main(void)
+int main(int argc, char *argv[])
 {
+ const char *Record_Path = NULL,
+            *Replay_Path = NULL;
+ int         Arg;
+ uint64_t    Started;
+
+
+ for (Arg = 1; Arg < argc; Arg++)
+ {
+  if (strcmp(argv[Arg], "--record") == 0 && Arg + 1 < argc)
+    Record_Path = argv[++Arg];
+  else if (strcmp(argv[Arg], "--replay") == 0 && Arg + 1 < argc)
+    Replay_Path = argv[++Arg];
+  else if (strcmp(argv[Arg], "--pace") == 0)
+    Replay_Paced = 1;
+  else
+  {
+   printf("Usage: %s [--record FILE | --replay FILE [--pace]]\n", argv[0]);
+   return EXIT_FAILURE;
+  }
+ }
+
+ if (Replay_Path)
+ {
+  if (!Journal_Open(&Journal, Replay_Path) || Journal.Kind != Journal_Keys)
+  {
+   printf("Error %s is not a journal of keys\n", Replay_Path);
+   return EXIT_FAILURE;
+  }
+  Replaying = 1;
+ }
+ else if (Record_Path)
+ {
+  if (!Journal_Create(&Journal, Record_Path, Journal_Keys))
+  {
+   printf("Error cannot write %s\n", Record_Path);
+   return EXIT_FAILURE;
+  }
+  Recording = 1;
+ }
+
+ STATS_INIT();
+ Started = Journal_Clock();
  Ncurses_Initialization();
- Splash_Screen();
+ if (!Replaying) Splash_Screen();
  Term_Screen_Size_Detection();
  Board_Initialization();
  ScreenBorderSetup();
@@ -100,9 +194,21 @@ int main(void)
  Peg_Solitaire_Board();
  Board_Cursor();
  Info_Window(0);
- refresh();
+ wnoutrefresh(stdscr);
+ Frame_Flush();
+ Journal.Last = Journal_Clock(); /*the pace starts at the first frame*/
  ChoiceSelection();
  Ncurses_End();
+
+ if (Recording && !Journal_Close(&Journal, Game.Key))
+ {
+  printf("Error the journal %s is incomplete\n", Record_Path);
+  return EXIT_FAILURE;
+ }
+
+ if (Replaying)
+   return Replay_Verify(Started);
+
  return 0;
 }
 
@@ -115,7 +221,16 @@ int main(void)
 /*FUNCTION:*/
 void Ncurses_Initialization(void)
 {
- initscr();
+ /*A replay at full speed paints into /dev/null as a 24 x 80 vt100, so it
+   runs the same without a terminal*/
+
+ FILE *Null_Output = NULL;
+
+
+ if (Replaying && !Replay_Paced) Null_Output = fopen("/dev/null", "w");
+ if (Null_Output == NULL || newterm("vt100", Null_Output, stdin) == NULL)
+   initscr();
+
  if (has_colors() && start_color() == OK)
  {
   init_pair(1, COLOR_MAGENTA, COLOR_BLACK);
@@ -172,43 +287,10 @@ void Term_Screen_Size_Detection(void)
 /*FUNCTION:*/
 void Board_Initialization(void)
 {
- unsigned char board_row, board_col;
-
-
- beads = 44;
- Current_Board_Row = 4;
- Current_Board_Col = 4;
- Selected_Bead_Row = 'N',
- Selected_Bead_Col = 'N';
-
-
- /*Initializing the 4 non used 3x3 blocks to NULL (N)*/
- for (board_row = 0; board_row <= 2; board_row++)
-    for (board_col = 0; board_col <= 2; board_col++)
-    {
-     board[board_row][board_col] = 'N';
-     board[8 - board_row][board_col] = 'N';
-     board[board_row][8 - board_col] = 'N';
-     board[8 - board_row][8 - board_col] = 'N';
-    }
-
- /*Initialize all remaining blocks to beads represented by (X)*/
- for (board_row = 0; board_row <= 2; board_row++)
-    for (board_col = 3; board_col <= 5; board_col++)
-    {
-     board[board_row][board_col] = 'X';     /*Top 3x3 block*/
-     board[board_col][board_row] = 'X';     /*Left 3x3 block*/
-     board[8 - board_row][board_col] = 'X'; /*Bottom 3x3 block*/
-     board[board_col][8 - board_row] = 'X'; /*Right 3x3 block*/
-     board[board_row + 3][board_col] = 'X'; /*Central 3x3 block*/
-                                      /*Note the central element block is set!*/
-    }
-
- /*Uninitialize the central block represented by a space*/
- board[Current_Board_Row][Current_Board_Col] = ' ';
+ /*Every hole of the cross holds a bead (X) except the central hole*/
+ Game_Init(&Game);
 }
 
-
 /*FUNCTION:*/
 void ScreenBorderSetup(void)
 {
@@ -280,7 +362,9 @@ void MainMenu(unsigned char HighlightedChoice)
  };
 
 
- wclear(MenuSubWin);
+ STATS_BEGIN(Stats_Compose);
+
+ werase(MenuSubWin);
  wprintw(MenuSubWin, " %s", MainMenuArray[0]);
  for (Menu_Row = 1; Menu_Row <= 6; Menu_Row++)
  {
@@ -302,7 +386,9 @@ void MainMenu(unsigned char HighlightedChoice)
   }
  }
 
- wrefresh(MenuSubWin);
+ Dirty_Windows |= DIRTY_MENU;
+
+ STATS_END(Stats_Compose);
 }
 
 
@@ -310,34 +396,14 @@ void MainMenu(unsigned char HighlightedChoice)
 void Peg_Solitaire_Board(void)
 {
  unsigned char Game_Board_Row, Game_Board_Col;
- char          *Game_Board[] =
- {
-  "    0   1   2   3   4   5   6   7   8",
-  "              +---+---+---+",
-  "0             |   |   |   |             0",
-  "              +---+---+---+",
-  "1             |   |   |   |             1",
-  "              +---+---+---+",
-  "2             |   |   |   |             2",
-  "  +---+---+---+---+---+---+---+---+---+",
-  "3 |   |   |   |   |   |   |   |   |   | 3",
-  "  +---+---+---+---+---+---+---+---+---+",
-  "4 |   |   |   |   |   |   |   |   |   | 4",
-  "  +---+---+---+---+---+---+---+---+---+",
-  "5 |   |   |   |   |   |   |   |   |   | 5",
-  "  +---+---+---+---+---+---+---+---+---+",
-  "6             |   |   |   |             6",
-  "              +---+---+---+",
-  "7             |   |   |   |             7",
-  "              +---+---+---+",
-  "8             |   |   |   |             8",
-  "              +---+---+---+",
-  "    0   1   2   3   4   5   6   7   8"
- };
+ const char    *const *Game_Board = Board_Picture; /*of the board built for*/
 
 
+ STATS_BEGIN(Stats_Compose);
+
  /*Writes the Game_Board & the board beads to Screen Array*/
- for (Game_Board_Row = 0; Game_Board_Row < 21; Game_Board_Row++)
+ for (Game_Board_Row = 0; Game_Board_Row < BOARD_PICTURE_LINES;
+      Game_Board_Row++)
     for (Game_Board_Col = 0; Game_Board[Game_Board_Row][Game_Board_Col] != '\0';
          Game_Board_Col++)
     {
@@ -348,22 +414,24 @@ void Peg_Solitaire_Board(void)
        if ((Game_Board_Col % 4) == 0 && (Game_Board_Col / 4) != 0)
          if ((Game_Board_Row / 2) - 1 <= 8 && (Game_Board_Col / 4) - 1 <= 8)
          {
-          if (board[(Game_Board_Row / 2) - 1][(Game_Board_Col / 4) - 1] == 'N')
-            mvwaddch(MainSubWin, Game_Board_Row, Game_Board_Col+2, ' ');
+          if (Bitboard_Test(Game.Pegs, HOLE_INDEX((Game_Board_Row / 2) - 1,
+                                             (Game_Board_Col / 4) - 1)))
+            mvwaddch(MainSubWin, Game_Board_Row, Game_Board_Col + 2, 'X');
           else
-          {
-           mvwaddch(MainSubWin, Game_Board_Row, Game_Board_Col + 2,
-                    board[(Game_Board_Row / 2) - 1][(Game_Board_Col / 4) - 1]);
-          }
+            mvwaddch(MainSubWin, Game_Board_Row, Game_Board_Col + 2, ' ');
          }
     }
+
+ STATS_END(Stats_Compose);
 }
 
 
 /*FUNCTION:*/
 void Status_Window(void)
 {
- wclear(StatusSubWin);
+ STATS_BEGIN(Stats_Compose);
+
+ werase(StatusSubWin);
 
  switch (CurrentSubWindow)
  {
@@ -375,8 +443,8 @@ void Status_Window(void)
 
   case Menu:
        CurrentSubWindow = Main;
-       mvwprintw(StatusSubWin, 0, 1, "Row: %c", Current_Board_Row + 48);
-       mvwprintw(StatusSubWin, 1, 1, "Col: %c", Current_Board_Col + 48);
+       mvwprintw(StatusSubWin, 0, 1, "Row: %c", Game.Cursor_Row + 48);
+       mvwprintw(StatusSubWin, 1, 1, "Col: %c", Game.Cursor_Col + 48);
        mvwprintw(StatusSubWin, 2, 1, "Window: Main");
        break;
 
@@ -385,7 +453,9 @@ void Status_Window(void)
   break;
  }
 
- wrefresh(StatusSubWin);
+ Dirty_Windows |= DIRTY_STATUS;
+
+ STATS_END(Stats_Compose);
 }
 
 
@@ -396,7 +466,7 @@ void Info_Window(unsigned char Msg)
  {
   "Info:",
   "Options 1 to 6   only work in     the menu window",
-  "Keys: up down    left right tab   enter. Shortcut  keys for menu    are numbers 1    to 6 ",
+  "Keys: up down    left right tab   enter, u undo &  r redo. Shortcut keys for menu    are numbers 1-6",
   "Settings         feature not      implemented",
   "Bead selected",
   "Bead deselected",
@@ -408,17 +478,24 @@ void Info_Window(unsigned char Msg)
   "Stale mate no    moves possible",
   "Game saved",
   "Game loaded",
-  "Error game not   loaded"
+  "Error game not   loaded",
+  "Nothing to undo",
+  "Nothing to redo",
+  "Error game not   saved"
  };
 
 
- wclear(InfoSubWin);
+ STATS_BEGIN(Stats_Compose);
+
+ werase(InfoSubWin);
  mvwprintw(InfoSubWin, 0, 1, "%s", Info[0]);
 
  if (Msg != 0)
    mvwprintw(InfoSubWin, 2, 1, "%s", Info[Msg]);
 
- wrefresh(InfoSubWin);
+ Dirty_Windows |= DIRTY_INFO;
+
+ STATS_END(Stats_Compose);
 }
 
 
@@ -426,12 +503,11 @@ void Info_Window(unsigned char Msg)
 void ChoiceSelection(void)
 {
  int    Key;
- int    EnteredChoice;
+ int    EnteredChoice = 0;
+ int    Coalesced = 0;
 #ifdef NCURSES_MOUSE_VERSION
- char   total_values;
- char   Row_Value;
- char   Col_Value;
- MEVENT Mouse_Event;
+ int    Row_Value;
+ int    Col_Value;
 
 
  mousemask(ALL_MOUSE_EVENTS, NULL);
@@ -440,8 +516,13 @@ void ChoiceSelection(void)
 
  do
  {
-  Key = getch();
+  Key = Key_Read();
+  STATS_BEGIN(Stats_Dispatch);
 
+#ifdef PEG_LATENCY
+  if (Coalesced == 0) clock_gettime(CLOCK_MONOTONIC, &Input_Time);
+  Latency_Keys++;
+#endif
 
   switch (Key)
   {
@@ -456,18 +537,7 @@ void ChoiceSelection(void)
         {
          Board_Cursor_Clear();
 
-         if ( (Current_Board_Row == 8) &&
-             ((Current_Board_Col >= 3) && (Current_Board_Col <= 5))
-            )
-           Current_Board_Row = 0;
-         else if (  (Current_Board_Row == 5) &&
-                  (((Current_Board_Col >= 0) && (Current_Board_Col <= 2)) ||
-                   ((Current_Board_Col >= 6) && (Current_Board_Col <= 8))
-                  )
-                 )
-                Current_Board_Row = 3;
-
-         else Current_Board_Row++;
+         Game_Move_Cursor(&Game, 1, 0);
 
          Board_Cursor();
         }
@@ -485,17 +555,7 @@ void ChoiceSelection(void)
         {
          Board_Cursor_Clear();
 
-         if ( (Current_Board_Row == 0) &&
-             ((Current_Board_Col >= 3) && (Current_Board_Col <= 5))
-            )
-           Current_Board_Row = 8;
-         else if (  (Current_Board_Row == 3) &&
-                  (((Current_Board_Col >= 0) && (Current_Board_Col <= 2)) ||
-                   ((Current_Board_Col >= 6) && (Current_Board_Col <= 8))
-                  )
-                 )
-                Current_Board_Row = 5;
-         else Current_Board_Row--;
+         Game_Move_Cursor(&Game, -1, 0);
 
          Board_Cursor();
         }
@@ -507,19 +567,7 @@ void ChoiceSelection(void)
         {
          Board_Cursor_Clear();
 
-         if ( (Current_Board_Col == 0) &&
-             ((Current_Board_Row >= 3) && (Current_Board_Row <= 5)
-             )
-            )
-           Current_Board_Col = 8;
-         else if (  (Current_Board_Col == 3) &&
-                  (((Current_Board_Row >= 0) && (Current_Board_Row <= 2)) ||
-                   ((Current_Board_Row >= 6) && (Current_Board_Row <= 8))
-                  )
-                 )
-                Current_Board_Col = 5;
-
-         else Current_Board_Col--;
+         Game_Move_Cursor(&Game, 0, -1);
 
          Board_Cursor();
         }
@@ -531,19 +579,7 @@ void ChoiceSelection(void)
         {
          Board_Cursor_Clear();
 
-         if ( (Current_Board_Col == 8) &&
-             ((Current_Board_Row >= 3) && (Current_Board_Row <= 5)
-             )
-            )
-           Current_Board_Col = 0;
-         else if (  (Current_Board_Col == 5) &&
-                  (((Current_Board_Row >= 0) && (Current_Board_Row <= 2)) ||
-                   ((Current_Board_Row >= 6) && (Current_Board_Row <= 8))
-                  )
-                 )
-                Current_Board_Col = 3;
-
-         else Current_Board_Col++;
+         Game_Move_Cursor(&Game, 0, 1);
 
          Board_Cursor();
         }
@@ -552,55 +588,25 @@ void ChoiceSelection(void)
 
 #ifdef NCURSES_MOUSE_VERSION
    case KEY_MOUSE:
-        getmouse(&Mouse_Event);
-
-        /*Main Window*/
-        if ((/*board columns 3, 4 or 5*/
-             Mouse_Event.y >=  3 && Mouse_Event.y <= 19 &&
-             Mouse_Event.x >= 19 && Mouse_Event.x <= 27
-            ) ||
-            (/*board rows 3, 4 or 5*/
-             Mouse_Event.y >=  9 && Mouse_Event.y <= 13 &&
-             Mouse_Event.x >=  7 && Mouse_Event.x <= 39
-            )
-           )
+        /*Main Window: hole (r, c) of the board is at y 2r + 3, x 4c + 7*/
+        if (Mouse_Event.y >= 3 && Mouse_Event.y <= 2 * BOARD_SIZE + 1 &&
+            Mouse_Event.x >= 7 && Mouse_Event.x <= 4 * BOARD_SIZE + 3)
         {
-         if (CurrentSubWindow == Menu) Status_Window();
+         Row_Value = (Mouse_Event.y - 3) / 2;
+         Col_Value = (Mouse_Event.x - 7) / 4;
 
-         /*Checking for valid row*/
-         for (Row_Value = 3, total_values = 1; total_values <= 9;
-              Row_Value += 2, total_values++)
-         {
-          if (Mouse_Event.y == Row_Value) break; /*Valid row*/
-          else if (Row_Value > Mouse_Event.y)
-          {
-           Row_Value = 0;
+         /*Only a click right on a hole of the board*/
+         if ((Mouse_Event.y - 3) % 2 != 0 || (Mouse_Event.x - 7) % 4 != 0 ||
+             !Bitboard_Test(Valid_Holes, HOLE_INDEX(Row_Value, Col_Value)))
            break;
-          }
-         }
 
-         /*Checking for valid col*/
-         for (Col_Value = 7, total_values = 1; total_values <= 9;
-              Col_Value += 4, total_values++)
-         {
-          if (Mouse_Event.x == Col_Value) break; /*Valid col*/
-          else if (Col_Value > Mouse_Event.x)
-          {
-           Col_Value = 0;
-           break;
-          }
-         }
+         if (CurrentSubWindow == Menu) Status_Window();
 
-         /*Get Board co-ordinates*/
-         if ((Row_Value != 0) && (Col_Value != 0))
-         {
-          Board_Cursor_Clear();
-          Current_Board_Row = (Row_Value - 3) / 2;
-          Current_Board_Col = (Col_Value - 7) / 4;
-          Board_Cursor();
-          Key = ENTER_KEY;
-         }
-         else break;
+         Board_Cursor_Clear();
+         Game.Cursor_Row = Row_Value;
+         Game.Cursor_Col = Col_Value;
+         Board_Cursor();
+         Key = ENTER_KEY;
         }
 
         /*Menu Window*/
@@ -651,6 +657,16 @@ void ChoiceSelection(void)
    break;
 
 
+   case 'u':
+        if (CurrentSubWindow == Main) Undo_Jump();
+   break;
+
+
+   case 'r':
+        if (CurrentSubWindow == Main) Redo_Jump();
+   break;
+
+
    case ESCAPE_KEY:
         EnteredChoice = 6;
    break;
@@ -677,7 +693,7 @@ void ChoiceSelection(void)
           Board_Initialization();
           Peg_Solitaire_Board();
           Board_Cursor();
-          wrefresh(MainSubWin);
+          Dirty_Windows |= DIRTY_MAIN;
           Info_Window(10);
           Status_Window();
      break;
@@ -707,90 +723,242 @@ void ChoiceSelection(void)
    }
    else if (CurrentSubWindow == Main)
    {
-    if (board[Current_Board_Row][Current_Board_Col] == ' ' &&
-        Selected_Bead_Row == 'N' && Selected_Bead_Col == 'N')
+    if (!Bitboard_Test(Game.Pegs, HOLE_INDEX(Game.Cursor_Row, Game.Cursor_Col)) &&
+        Game.Selected_Row == GAME_NONE && Game.Selected_Col == GAME_NONE)
       /*Empty block*/
       Info_Window(6);
-    else if (board[Current_Board_Row][Current_Board_Col] == ' ' &&
-             Selected_Bead_Row != 'N' && Selected_Bead_Col != 'N'
+    else if (!Bitboard_Test(Game.Pegs, HOLE_INDEX(Game.Cursor_Row, Game.Cursor_Col)) &&
+             Game.Selected_Row != GAME_NONE && Game.Selected_Col != GAME_NONE
             )
            /*Do calculations for valid hop*/
            Bead_Manager();
-    else if (board[Current_Board_Row][Current_Board_Col] == 'X' &&
-             Selected_Bead_Row == 'N' && Selected_Bead_Col == 'N'
+    else if (Bitboard_Test(Game.Pegs, HOLE_INDEX(Game.Cursor_Row, Game.Cursor_Col)) &&
+             Game.Selected_Row == GAME_NONE && Game.Selected_Col == GAME_NONE
             )
     {
      /*Selects a bead*/
-     Selected_Bead_Row = Current_Board_Row;
-     Selected_Bead_Col = Current_Board_Col;
+     Game.Selected_Row = Game.Cursor_Row;
+     Game.Selected_Col = Game.Cursor_Col;
      Info_Window(4);
     }
-    else if (board[Current_Board_Row][Current_Board_Col] == 'X' &&
-             Selected_Bead_Row == Current_Board_Row &&
-             Selected_Bead_Col == Current_Board_Col
+    else if (Bitboard_Test(Game.Pegs, HOLE_INDEX(Game.Cursor_Row, Game.Cursor_Col)) &&
+             Game.Selected_Row == Game.Cursor_Row &&
+             Game.Selected_Col == Game.Cursor_Col
             )
     {
      /*Deselects a bead & clears bead cursor*/
      Board_Cursor();
-     Selected_Bead_Row = 'N';
-     Selected_Bead_Col = 'N';
+     Game.Selected_Row = GAME_NONE;
+     Game.Selected_Col = GAME_NONE;
      Board_Cursor();
      Info_Window(5);
     }
-    else if (board[Current_Board_Row][Current_Board_Col] == 'X' &&
-             Selected_Bead_Row != 'N' && Selected_Bead_Col != 'N')
+    else if (Bitboard_Test(Game.Pegs, HOLE_INDEX(Game.Cursor_Row, Game.Cursor_Col)) &&
+             Game.Selected_Row != GAME_NONE && Game.Selected_Col != GAME_NONE)
     {
      /*Cannot select another bead*/
      Info_Window(8);
     }
    }
   }
+
+  STATS_END(Stats_Dispatch);
+
+  /*Paints once per burst of input: keys already waiting are handled first
+    so held down arrows only draw the cursor where it ends up*/
+  if (++Coalesced >= FRAME_COALESCE_MAX || !Input_Pending())
+  {
+   Frame_Flush();
+   Coalesced = 0;
+  }
+
+  STATS_POLL();
  }
  while ((Key != ESCAPE_KEY) || (EnteredChoice != 6));
 }
 
 
+/*FUNCTION:*/
+int Key_Read(void)
+{
+ /*getch, or the next key of the journal with --replay, waiting as long as
+   it was pressed after the one before with --pace. With --record each key
+   is journaled, KEY_MOUSE together with its event. A journal that runs out
+   is escape, which quits*/
+
+ uint64_t Delay, Values[JOURNAL_VALUES];
+ int      Key, Count = 1;
+
+
+ if (Replaying)
+ {
+  if (!Journal_Read(&Journal, &Delay, Values, &Count)) return ESCAPE_KEY;
+  if (Replay_Paced) Journal_Wait(Journal.Last);
+
+  Key = (int) (unsigned int) Values[0];
+#ifdef NCURSES_MOUSE_VERSION
+  if (Key == KEY_MOUSE && Count == JOURNAL_VALUES)
+  {
+   Mouse_Event.y      = (int) (unsigned int) Values[1];
+   Mouse_Event.x      = (int) (unsigned int) Values[2];
+   Mouse_Event.bstate = (mmask_t) Values[3];
+  }
+#endif
+  return Key;
+ }
+
+ /*SIGUSR1 of PEG_STATS cuts the wait short, the report is written then*/
+ STATS_BEGIN(Stats_Input);
+ errno = 0;
+ while ((Key = getch()) == ERR && errno == EINTR)
+ {
+  STATS_POLL();
+  errno = 0;
+ }
+ STATS_END(Stats_Input);
+
+#ifdef NCURSES_MOUSE_VERSION
+ if (Key == KEY_MOUSE) getmouse(&Mouse_Event);
+#endif
+
+ if (Recording)
+ {
+  Values[0] = (unsigned int) Key;
+#ifdef NCURSES_MOUSE_VERSION
+  if (Key == KEY_MOUSE)
+  {
+   Values[1] = (unsigned int) Mouse_Event.y;
+   Values[2] = (unsigned int) Mouse_Event.x;
+   Values[3] = (uint64_t) Mouse_Event.bstate;
+   Count     = JOURNAL_VALUES;
+  }
+#endif
+  Journal_Write(&Journal, Values, Count);
+ }
+
+ return Key;
+}
+
+
+/*FUNCTION:*/
+int Input_Pending(void)
+{
+ /*Peeks without waiting, the key is pushed back for the next getch. A paced
+   replay paints after every key, one at full speed paints nothing*/
+
+ int Key;
+
+
+ if (Replaying) return !Replay_Paced;
+
+ STATS_BEGIN(Stats_Input);
+ nodelay(stdscr, TRUE);
+ Key = getch();
+ nodelay(stdscr, FALSE);
+ STATS_END(Stats_Input);
+
+ if (Key == ERR) return 0;
+
+ ungetch(Key);
+ return 1;
+}
+
+
+/*FUNCTION:*/
+void Frame_Flush(void)
+{
+ /*Copies the dirty subwindows to the virtual screen & updates the terminal
+   once, instead of 1 wrefresh per subwindow drawn. The menu & info borders
+   overlap nothing so the order only matters for where the cursor is left*/
+
+#ifdef PEG_LATENCY
+ struct timespec Paint_Time;
+ double          Latency;
+#endif
+
+
+ if (Replaying && !Replay_Paced)
+ {
+  Dirty_Windows = 0;
+  return;
+ }
+
+ STATS_BEGIN(Stats_Compose);
+ if (Dirty_Windows & DIRTY_MENU)   wnoutrefresh(MenuSubWin);
+ if (Dirty_Windows & DIRTY_INFO)   wnoutrefresh(InfoSubWin);
+ if (Dirty_Windows & DIRTY_STATUS) wnoutrefresh(StatusSubWin);
+ if (Dirty_Windows & DIRTY_MAIN)   wnoutrefresh(MainSubWin);
+ Dirty_Windows = 0;
+ STATS_END(Stats_Compose);
+
+ STATS_BEGIN(Stats_Output);
+ doupdate();
+ STATS_END(Stats_Output);
+
+#ifdef PEG_LATENCY
+ clock_gettime(CLOCK_MONOTONIC, &Paint_Time);
+ Latency = (Paint_Time.tv_sec  - Input_Time.tv_sec)  * 1e6 +
+           (Paint_Time.tv_nsec - Input_Time.tv_nsec) / 1e3;
+
+ if (Latency_Keys > 0)
+ {
+  Latency_Frames++;
+  Latency_Total += Latency;
+  if (Latency > Latency_Max) Latency_Max = Latency;
+ }
+#endif
+}
+
+
 /*FUNCTION:*/
 void Board_Cursor_Clear(void)
 {
- mvwaddch(MainSubWin, Current_Board_Row * 2 + 2, Current_Board_Col * 4 + 5, ' ');
- mvwaddch(MainSubWin, Current_Board_Row * 2 + 2, Current_Board_Col * 4 + 7, ' ');
+ STATS_BEGIN(Stats_Compose);
+
+ mvwaddch(MainSubWin, Game.Cursor_Row * 2 + 2, Game.Cursor_Col * 4 + 5, ' ');
+ mvwaddch(MainSubWin, Game.Cursor_Row * 2 + 2, Game.Cursor_Col * 4 + 7, ' ');
+
+ STATS_END(Stats_Compose);
 }
 
 
 /*FUNCTION:*/
 void Board_Cursor(void)
 {
+ STATS_BEGIN(Stats_Compose);
+
  /*Writes new cursor position*/
  wattrset(MainSubWin, COLOR_PAIR(2) | A_BOLD);
- mvwaddch(MainSubWin, Current_Board_Row * 2 + 2, Current_Board_Col * 4 + 5, '[');
- mvwaddch(MainSubWin, Current_Board_Row * 2 + 2, Current_Board_Col * 4 + 7, ']');
+ mvwaddch(MainSubWin, Game.Cursor_Row * 2 + 2, Game.Cursor_Col * 4 + 5, '[');
+ mvwaddch(MainSubWin, Game.Cursor_Row * 2 + 2, Game.Cursor_Col * 4 + 7, ']');
  wattrset(MainSubWin, COLOR_PAIR(0));
 
  /*Writes selected bead's cursor position*/
- if (Selected_Bead_Row != 'N' && Selected_Bead_Col != 'N')
+ if (Game.Selected_Row != GAME_NONE && Game.Selected_Col != GAME_NONE)
  {
   wattrset(MainSubWin, COLOR_PAIR(3));
-  mvwaddch(MainSubWin, Selected_Bead_Row * 2 + 2,
-           Selected_Bead_Col * 4 + 5, '[');
-  mvwaddch(MainSubWin, Selected_Bead_Row * 2 + 2,
-           Selected_Bead_Col * 4 + 7, ']');
+  mvwaddch(MainSubWin, Game.Selected_Row * 2 + 2,
+           Game.Selected_Col * 4 + 5, '[');
+  mvwaddch(MainSubWin, Game.Selected_Row * 2 + 2,
+           Game.Selected_Col * 4 + 7, ']');
   wattrset(MainSubWin, COLOR_PAIR(0));
  }
 
  if (Valid_Bead_Hop)
  {
   /*Clears the selected bead cursor after a valid hop*/
-  mvwaddch(MainSubWin, Selected_Bead_Row * 2 + 2,
-           Selected_Bead_Col * 4 + 5, ' ');
-  mvwaddch(MainSubWin, Selected_Bead_Row * 2 + 2,
-           Selected_Bead_Col * 4 + 7, ' ');
+  mvwaddch(MainSubWin, Game.Selected_Row * 2 + 2,
+           Game.Selected_Col * 4 + 5, ' ');
+  mvwaddch(MainSubWin, Game.Selected_Row * 2 + 2,
+           Game.Selected_Col * 4 + 7, ' ');
   Valid_Bead_Hop = 0;
  }
 
- wrefresh(MainSubWin);
+ Dirty_Windows |= DIRTY_MAIN;
  Status_Window();
  Status_Window();
+
+ STATS_END(Stats_Compose);
 }
 
 
@@ -798,346 +966,124 @@ void Board_Cursor(void)
 void Bead_Manager(void)
 {
  /*The Bead_Manager will validate correct & incorrect bead moves, keeps track
-   of total amount of beads left, writes to the board array */
+   of total amount of beads left, writes to the board bitboard. Game_Apply
+   looks the move up in the jump table of the selected hole, toggles the
+   from, over & to holes in one XOR & logs the jump for undo*/
+
+ STATS_BEGIN(Stats_Rules);
 
- if (Selected_Bead_Row != 'N' &&
-     board[Current_Board_Row][Current_Board_Col] == ' ')
+ if (Game.Selected_Row != GAME_NONE &&
+     Game_Apply(&Game, HOLE_INDEX(Game.Selected_Row, Game.Selected_Col),
+                       HOLE_INDEX(Game.Cursor_Row, Game.Cursor_Col)))
  {
-  if (Current_Board_Col == Selected_Bead_Col)
-  {
-   if (((Current_Board_Row > Selected_Bead_Row) &&
-        (Current_Board_Row - Selected_Bead_Row == 2)) ||
-       ((Selected_Bead_Row > Current_Board_Row) &&
-        (Selected_Bead_Row - Current_Board_Row == 2))
-      )
-     if (board[(Current_Board_Row + Selected_Bead_Row) / 2][Current_Board_Col]
-                                                                         == 'X')
-     {
-      /*Erase the 2 beads & write the 1 bead*/
-      board[Selected_Bead_Row][Selected_Bead_Col] = ' ';
-      board[(Current_Board_Row + Selected_Bead_Row)/2][Current_Board_Col] = ' ';
-      board[Current_Board_Row][Current_Board_Col] = 'X';
-      Peg_Solitaire_Board();
-      Valid_Bead_Hop = 1;
-      Board_Cursor();
-      Selected_Bead_Row = 'N';
-      Selected_Bead_Col = 'N';
-      Board_Cursor();
-      if (beads > 1) beads--;
-      Info_Window(7);
-      mvwaddch(InfoSubWin, 2, 13, beads / 10 + 48);
-      mvwaddch(InfoSubWin, 2, 14, beads % 10 + 48);
-      wrefresh(InfoSubWin);
-     }
-  }
-  else if (Current_Board_Row == Selected_Bead_Row)
-  {
-   if (((Current_Board_Col > Selected_Bead_Col) &&
-        (Current_Board_Col - Selected_Bead_Col == 2)) ||
-       ((Selected_Bead_Col > Current_Board_Col) &&
-        (Selected_Bead_Col - Current_Board_Col == 2))
-      )
-     if (board[Current_Board_Row][(Current_Board_Col + Selected_Bead_Col) / 2]
-                                                                         == 'X')
-     {
-      board[Selected_Bead_Row][Selected_Bead_Col] = ' ';
-      board[Current_Board_Row][(Current_Board_Col + Selected_Bead_Col)/2] = ' ';
-      board[Current_Board_Row][Current_Board_Col] = 'X';
-      Peg_Solitaire_Board();
-      Valid_Bead_Hop = 1;
-      Board_Cursor();
-      Selected_Bead_Row = 'N';
-      Selected_Bead_Col = 'N';
-      Board_Cursor();
-      if (beads > 1) beads--;
-      Info_Window(7);
-      mvwaddch(InfoSubWin, 2, 13, beads / 10 + 48);
-      mvwaddch(InfoSubWin, 2, 14, beads % 10 + 48);
-      wrefresh(InfoSubWin);
-     }
-  }
+  Peg_Solitaire_Board();
+  Valid_Bead_Hop = 1;
+  Board_Cursor();
+  Game.Selected_Row = GAME_NONE;
+  Game.Selected_Col = GAME_NONE;
+  Board_Cursor();
+  Info_Window(7);
+  mvwaddch(InfoSubWin, 2, 13, Game.Beads / 10 + 48);
+  mvwaddch(InfoSubWin, 2, 14, Game.Beads % 10 + 48);
+  Dirty_Windows |= DIRTY_INFO;
  }
 
+ STATS_END(Stats_Rules);
  Stale_Mate_Checker();
 }
 
-
 /*FUNCTION:*/
 void Stale_Mate_Checker(void)
 {
- /*If the total amount of beads is less than 25 then check each bead on the
-   board to see whether there is an adjacent bead above, below, right or left
-   of the bead
-
-   Restraints:
-    - Above row 0
-    - 2 blocks above row 1
-    - 2 blocks below row 7
-    - Below row 8
-    - Left of col 0
-    - 2 blocks left of col 0
-    - 2 blocks right of col 7
-    - Right of col 8
-
-   stale_mate variable = 0 or 1 which is false or true
-   if 1 bead is left & is not in the centre then it is stale mate
-   if a complete row or column is filled with beads
- */
-
- unsigned char board_row, board_col, stale_mate = 1;
-
-
- if (beads <= 24)
- {
-  for (board_row = 0; board_row <= 8; board_row++)
-  {
-   for (board_col = 0; board_col <= 8; board_col++)
-   {
-    if ((board[board_row][board_col] == 'N') ||
-        (board[board_row][board_col] == ' '))
-      continue;
+ /*1 bead left on the finish, the centre board[4][4] of the cross, solves
+   the puzzle. Otherwise it is stale mate when the engine finds no legal
+   jump, it tests every bead in all directions at once with whole board
+   shifts so no edge of the board needs a special case*/
 
-    if (board[board_row][board_col] == 'X')
-    {
-     if (board_row == 0)
-     {
-      if ((board[board_row    ][board_col + 1] == 'X'  &&
-           board[board_row    ][board_col + 2] == ' ') ||
-          (board[board_row + 1][board_col    ] == 'X'  &&
-           board[board_row + 2][board_col    ] == ' ') ||
-          (board[board_row    ][board_col - 1] == 'X'  &&
-           board[board_row    ][board_col - 2] == ' ')
-         )
-      {
-       stale_mate = 0;
-       break;
-      }
-     }
-     else if (board_row == 1)
-     {
-      if ((board[board_row - 1][board_col    ] == 'X'  &&
-           board[board_row + 1][board_col    ] == ' ') ||
-          (board[board_row    ][board_col + 1] == 'X'  &&
-           board[board_row    ][board_col + 2] == ' ') ||
-          (board[board_row + 1][board_col    ] == 'X'  &&
-           board[board_row + 2][board_col    ] == ' ') ||
-          (board[board_row    ][board_col - 1] == 'X'  &&
-           board[board_row    ][board_col - 2] == ' ')
-         )
-      {
-       stale_mate = 0;
-       break;
-      }
-     }
-     else if (board_row == 7)
-     {
-      if ((board[board_row - 1][board_col    ] == 'X'  &&
-           board[board_row - 2][board_col    ] == ' ') ||
-          (board[board_row    ][board_col + 1] == 'X'  &&
-           board[board_row    ][board_col + 2] == ' ') ||
-          (board[board_row + 1][board_col    ] == 'X'  &&
-           board[board_row - 1][board_col    ] == ' ') ||
-          (board[board_row    ][board_col - 1] == 'X'  &&
-           board[board_row    ][board_col - 2] == ' ')
-         )
-      {
-       stale_mate = 0;
-       break;
-      }
-
-     }
-     else if (board_row == 8)
-     {
-      if ((board[board_row - 1][board_col    ] == 'X'  &&
-           board[board_row - 2][board_col    ] == ' ') ||
-          (board[board_row    ][board_col + 1] == 'X'  &&
-           board[board_row    ][board_col + 2] == ' ') ||
-          (board[board_row    ][board_col - 1] == 'X'  &&
-           board[board_row    ][board_col - 2] == ' ')
-         )
-      {
-       stale_mate = 0;
-       break;
-      }
-     }
-     else if (board_col == 0)
-     {
-      if ((board[board_row - 1][board_col    ] == 'X'  &&
-           board[board_row - 2][board_col    ] == ' ') ||
-          (board[board_row    ][board_col + 1] == 'X'  &&
-           board[board_row    ][board_col + 2] == ' ') ||
-          (board[board_row + 1][board_col    ] == 'X'  &&
-           board[board_row + 2][board_col    ] == ' ')
-         )
-      {
-       stale_mate = 0;
-       break;
-      }
-     }
-     else if (board_col == 1)
-     {
-      if ((board[board_row - 1][board_col    ] == 'X'  &&
-           board[board_row - 2][board_col    ] == ' ') ||
-          (board[board_row    ][board_col + 1] == 'X'  &&
-           board[board_row    ][board_col + 2] == ' ') ||
-          (board[board_row + 1][board_col    ] == 'X'  &&
-           board[board_row + 2][board_col    ] == ' ') ||
-          (board[board_row    ][board_col - 1] == 'X'  &&
-           board[board_row    ][board_col + 1] == ' ')
-         )
-      {
-       stale_mate = 0;
-       break;
-      }
-     }
-     else if (board_col == 7)
-     {
-      if ((board[board_row - 1][board_col    ] == 'X'  &&
-           board[board_row - 2][board_col    ] == ' ') ||
-          (board[board_row    ][board_col + 1] == 'X'  &&
-           board[board_row    ][board_col - 1] == ' ') ||
-          (board[board_row + 1][board_col    ] == 'X'  &&
-           board[board_row + 2][board_col    ] == ' ') ||
-          (board[board_row    ][board_col - 1] == 'X'  &&
-           board[board_row    ][board_col - 2] == ' ')
-         )
-      {
-       stale_mate = 0;
-       break;
-      }
-     }
-     else if (board_col == 8)
-     {
-      if ((board[board_row - 1][board_col    ] == 'X'  &&
-           board[board_row - 2][board_col    ] == ' ') ||
-          (board[board_row + 1][board_col    ] == 'X'  &&
-           board[board_row + 2][board_col    ] == ' ') ||
-          (board[board_row    ][board_col - 1] == 'X'  &&
-           board[board_row    ][board_col - 2] == ' ')
-         )
-      {
-       stale_mate = 0;
-       break;
-      }
-     }
-     else
-     {
-      if ((board[board_row - 1][board_col    ] == 'X'  &&
-           board[board_row - 2][board_col    ] == ' ') ||
-          (board[board_row    ][board_col + 1] == 'X'  &&
-           board[board_row    ][board_col + 2] == ' ') ||
-          (board[board_row + 1][board_col    ] == 'X'  &&
-           board[board_row + 2][board_col    ] == ' ') ||
-          (board[board_row    ][board_col - 1] == 'X'  &&
-           board[board_row    ][board_col - 2] == ' ')
-         )
-      {
-       stale_mate = 0;
-       break;
-      }
-     }
-    }
-   }
-  }
+ STATS_BEGIN(Stats_Rules);
 
-  if (beads == 1 && board[4][4] == 'X')
-  {
-   stale_mate = 0;
+ if (Game_Is_Won(&Game))
    Info_Window(9);
-  }
-  else if (beads == 1 && board[4][4] != 'X')
-         stale_mate = 1;
+ else if (Game_Is_Stalemate(&Game))
+   Info_Window(11);
 
+ Dirty_Windows |= DIRTY_INFO;
 
+ STATS_END(Stats_Rules);
+}
+
+/*FUNCTION:*/
+void Undo_Jump(void)
+{
+ /*Takes back the last jump, it stays in the log so redo can make it again*/
 
-  if (stale_mate == 1)
-    Info_Window(11);
+ if (!Game_Undo(&Game))
+ {
+  Info_Window(15);
+  return;
  }
 
- wrefresh(InfoSubWin);
+ Game.Selected_Row = GAME_NONE;
+ Game.Selected_Col = GAME_NONE;
+ Peg_Solitaire_Board();
+ Board_Cursor();
+ Info_Window(7);
+ mvwaddch(InfoSubWin, 2, 13, Game.Beads / 10 + 48);
+ mvwaddch(InfoSubWin, 2, 14, Game.Beads % 10 + 48);
+ Dirty_Windows |= DIRTY_INFO;
 }
 
-
 /*FUNCTION:*/
-void Save_Game(void)
+void Redo_Jump(void)
 {
- FILE *fp;
- unsigned char i,j;
- struct Saved_Data_Struct
- {
-  int board[9][9],
-      beads,
-      Current_Board_Row,
-      Current_Board_Col,
-      Selected_Bead_Row,
-      Selected_Bead_Col;
- } Saved_Data;
-
-
- for (i = 0; i <= 8; i++)
-    for (j = 0; j <= 8; j++)
-       Saved_Data.board[i][j] = board[i][j];
-
- Saved_Data.beads = beads;
- Saved_Data.Current_Board_Row = Current_Board_Row;
- Saved_Data.Current_Board_Col = Current_Board_Col;
- Saved_Data.Selected_Bead_Row = Selected_Bead_Row;
- Saved_Data.Selected_Bead_Col = Selected_Bead_Col;
-
- fp = fopen("peg_solitaire.save", "wb");
- if (fp)
+ if (!Game_Redo(&Game))
  {
-  fwrite(&Saved_Data, sizeof(Saved_Data), 1, fp);
-  fclose(fp);
+  Info_Window(16);
+  return;
  }
 
- Info_Window(12);
+ Game.Selected_Row = GAME_NONE;
+ Game.Selected_Col = GAME_NONE;
+ Peg_Solitaire_Board();
+ Board_Cursor();
+ Info_Window(7);
+ mvwaddch(InfoSubWin, 2, 13, Game.Beads / 10 + 48);
+ mvwaddch(InfoSubWin, 2, 14, Game.Beads % 10 + 48);
+ Stale_Mate_Checker();
 }
 
-
 /*FUNCTION:*/
-void Load_Game(void)
+void Save_Game(void)
 {
- FILE *fp;
- unsigned char i,j;
- struct Saved_Data_Struct
- {
-  int board[9][9],
-      beads,
-      Current_Board_Row,
-      Current_Board_Col,
-      Selected_Bead_Row,
-      Selected_Bead_Col;
- } Saved_Data;
+ /*Writes the versioned binary save of Peg_Engine/peg_save.h, the move log
+   included so undo & redo carry over*/
 
+ if (Save_Write("peg_solitaire.save", &Game))
+   Info_Window(12);
+ else Info_Window(17);
+}
 
- fp = fopen("peg_solitaire.save", "rb");
- if (fp)
- {
-  fread(&Saved_Data, sizeof(Saved_Data), 1, fp);
-  fclose(fp);
-
+/*FUNCTION:*/
+void Load_Game(void)
+{
+ /*Only a save that passes every check of Save_Read replaces the game, a
+   missing, old or damaged file leaves the board as it is*/
 
-  for (i = 0; i <= 8; i++)
-     for (j = 0; j <= 8; j++)
-        board[i][j] = Saved_Data.board[i][j];
+ struct Peg_Game Loaded;
 
-  beads = Saved_Data.beads;
-  Current_Board_Row = Saved_Data.Current_Board_Row;
-  Current_Board_Col = Saved_Data.Current_Board_Col;
-  Selected_Bead_Row = Saved_Data.Selected_Bead_Row;
-  Selected_Bead_Col = Saved_Data.Selected_Bead_Col;
 
+ if (Save_Read("peg_solitaire.save", &Loaded))
+ {
+  Game = Loaded;
   Info_Window(13);
   Peg_Solitaire_Board();
   Board_Cursor();
-  wrefresh(MainSubWin);
+  Dirty_Windows |= DIRTY_MAIN;
   Status_Window();
  }
  else Info_Window(14);
 }
 
-
 /*FUNCTION:*/
 void DestroySubWindows(void)
 {
@@ -1155,4 +1101,32 @@ void Ncurses_End(void)
  refresh();
  DestroySubWindows();
  endwin();
+
+#ifdef PEG_LATENCY
+ if (Latency_Frames > 0)
+   fprintf(stderr, "keys %ld frames %ld latency mean %.1f us max %.1f us\n",
+           Latency_Keys, Latency_Frames, Latency_Total / Latency_Frames,
+           Latency_Max);
+#endif
+
+ STATS_REPORT();
+}
+
+
+/*FUNCTION:*/
+int Replay_Verify(uint64_t Started)
+{
+ /*After the last key the journal must end with the key of the board the
+   replay finished on*/
+
+ double Elapsed = (Journal_Clock() - Started) / 1e3;
+ int    Same    = Journal_Verify(&Journal, Game.Key);
+
+
+ printf("replay %lu keys in %.3f ms, board %016llx %s\n",
+        Journal.Records, Elapsed, (unsigned long long) Game.Key,
+        !Journal.Complete ? "(journal cut short, not checked)" :
+        Same ? "matches" : "differs from the recording");
+
+ return Same ? EXIT_SUCCESS : EXIT_FAILURE;
 }
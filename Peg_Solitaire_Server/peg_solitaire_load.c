@@ -0,0 +1,516 @@
+/*Date:    17Oct2026Sat 17:30
+//File:    peg_solitaire_load.c
+//Desc:    Load generator for the Peg Solitaire line protocol. Plays N
+           synthetic players at once, either against a running
+           peg_solitaire_server or in process straight on Session_Command,
+           & prints 1 JSON object: throughput, latency percentiles & memory
+           per session, so runs can be compared between releases.
+
+           Commands come from the vocabulary of peg_session.h, at random
+           (moves & select most often) or from a script file of 1 command
+           per line that every session plays from its own starting line
+           round & round. Against the server each session is 1 connection
+           with up to --depth commands in flight; latency is from writing a
+           command to reading its reply line. In process it is the time of
+           1 Session_Command call.
+
+
+           To compile with gcc command:
+            gcc -Wall -Werror -Wextra -Wunused -O2 peg_solitaire_load.c ../Peg_Engine/peg_engine.c ../Peg_Engine/peg_command.c ../Peg_Engine/peg_session.c -o peg_solitaire_load
+           To run in process: ./peg_solitaire_load --sessions 10000 --commands 100
+           To run against the server:
+            ./peg_solitaire_server /tmp/peg_solitaire.sock &
+            ./peg_solitaire_load --socket /tmp/peg_solitaire.sock --server-pid $! --sessions 500 --commands 10000 --depth 16
+           Options: --sessions N     players (default 1000)
+                    --commands N     commands per player (default 1000)
+                    --seed N         random stream seed (default 1)
+                    --script FILE    play FILE instead of random commands
+                    --socket PATH    drive the server on PATH
+                    --depth N        with --socket, commands in flight per
+                                     player (default 1)
+                    --server-pid N   with --socket, measure memory per session
+                                     from the resident size of that process
+
+           Output fields: mode, sessions, commands, seconds, throughput
+           (commands per second), latency_ns p50 p99 p999 max (to within
+           1 / 16 of the value), memory_per_session_bytes (null when not
+           measured), errors (connections lost).
+*/
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#define _GNU_SOURCE
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+#include "../Peg_Engine/peg_session.h"
+
+#define LOAD_BUCKETS      976  /*latency histogram, 16 buckets per power of 2*/
+#define LOAD_SCRIPT_LINES 4096
+#define LOAD_EVENTS       256
+#define LOAD_DEPTH_MAX    64
+#define LOAD_LINE_BYTES   64   /*of a script line, newline & NUL included*/
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+/*1 player: where it is in its command stream & its commands in flight*/
+struct Load_Player
+{
+ uint64_t           Random;    /*xorshift state, or the script line*/
+ unsigned long      Sent,
+                    Received;
+ int                Fd;        /*server connection, -1 in process*/
+ uint64_t           Sent_Time[LOAD_DEPTH_MAX]; /*ns, by Sent % depth*/
+};
+
+
+/*----------------------------
+//Global Variable Declarations
+----------------------------*/
+const char *Random_Commands[] =
+{
+ "up", "down", "left", "right", "select",
+ "up", "down", "left", "right", "select",
+ "select", "board", "save", "load", "new", "select"
+};
+
+char *Script[LOAD_SCRIPT_LINES];
+int   Script_Lines = 0;
+
+unsigned long Latency_Histogram[LOAD_BUCKETS],
+              Latency_Count = 0,
+              Errors        = 0;
+uint64_t      Latency_Max   = 0;
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+uint64_t    Load_Now(void);
+const char *Load_Next_Command(struct Load_Player *Player);
+void        Load_Record(uint64_t Latency);
+uint64_t    Load_Percentile(double Fraction);
+long        Load_Resident_Bytes(long Pid);
+int         Load_Read_Script(const char *Path);
+void        Load_In_Process(struct Load_Player *Players,
+                            struct Peg_Session *Games, long Sessions,
+                            unsigned long Commands);
+int         Load_Server(struct Load_Player *Players, long Sessions,
+                        unsigned long Commands, int Depth, const char *Path,
+                        long Server_Pid, long *Session_Bytes);
+
+
+/*------------
+//Main Program
+------------*/
+int main(int argc, char *argv[])
+{
+ struct Load_Player *Players;
+ struct Peg_Session *Games = NULL;
+ const char         *Socket_Path = NULL;
+ unsigned long       Commands    = 1000,
+                     Seed        = 1;
+ long                Sessions    = 1000,
+                     Server_Pid  = 0,
+                     Session_Bytes = -1,
+                     Before, Index;
+ int                 Arg, Depth = 1;
+ uint64_t            Start, Stop;
+ double              Seconds;
+
+
+ for (Arg = 1; Arg < argc; Arg++)
+ {
+  if (strcmp(argv[Arg], "--sessions") == 0 && Arg + 1 < argc)
+    Sessions = atol(argv[++Arg]);
+  else if (strcmp(argv[Arg], "--commands") == 0 && Arg + 1 < argc)
+    Commands = strtoul(argv[++Arg], NULL, 10);
+  else if (strcmp(argv[Arg], "--seed") == 0 && Arg + 1 < argc)
+    Seed = strtoul(argv[++Arg], NULL, 10);
+  else if (strcmp(argv[Arg], "--script") == 0 && Arg + 1 < argc)
+  {
+   if (!Load_Read_Script(argv[++Arg]))
+   {
+    perror(argv[Arg]);
+    return EXIT_FAILURE;
+   }
+  }
+  else if (strcmp(argv[Arg], "--socket") == 0 && Arg + 1 < argc)
+    Socket_Path = argv[++Arg];
+  else if (strcmp(argv[Arg], "--depth") == 0 && Arg + 1 < argc)
+    Depth = atoi(argv[++Arg]);
+  else if (strcmp(argv[Arg], "--server-pid") == 0 && Arg + 1 < argc)
+    Server_Pid = atol(argv[++Arg]);
+  else
+  {
+   printf("Usage: %s [--sessions N] [--commands N] [--seed N] "
+          "[--script FILE] [--socket PATH [--depth N] [--server-pid N]]\n",
+          argv[0]);
+   return EXIT_FAILURE;
+  }
+ }
+
+ if (Sessions < 1) Sessions = 1;
+ if (Depth < 1) Depth = 1;
+ if (Depth > LOAD_DEPTH_MAX) Depth = LOAD_DEPTH_MAX;
+
+ Players = calloc(Sessions, sizeof(struct Load_Player));
+ if (Players == NULL)
+ {
+  perror("calloc");
+  return EXIT_FAILURE;
+ }
+
+ /*Resident size before & after the sessions are made gives what 1 in
+   process session costs, the server measures its own in Load_Server*/
+ if (Socket_Path == NULL)
+ {
+  Before = Load_Resident_Bytes(0);
+  Games  = malloc(Sessions * sizeof(struct Peg_Session));
+  if (Games == NULL)
+  {
+   perror("malloc");
+   return EXIT_FAILURE;
+  }
+
+  for (Index = 0; Index < Sessions; Index++)
+    Session_Init(&Games[Index]);
+
+  if (Before > 0)
+    Session_Bytes = (Load_Resident_Bytes(0) - Before) / Sessions;
+ }
+
+ for (Index = 0; Index < Sessions; Index++)
+ {
+  Players[Index].Random = Script_Lines ? (uint64_t) Index % Script_Lines
+                        : (Seed + 1) * 0x9e3779b97f4a7c15ULL ^ (Index + 1);
+  Players[Index].Fd     = -1;
+ }
+
+ Start = Load_Now();
+ if (Socket_Path == NULL)
+   Load_In_Process(Players, Games, Sessions, Commands);
+ else if (!Load_Server(Players, Sessions, Commands, Depth, Socket_Path,
+                       Server_Pid, &Session_Bytes))
+ {
+  perror(Socket_Path);
+  return EXIT_FAILURE;
+ }
+ Stop    = Load_Now();
+ Seconds = (Stop - Start) / 1e9;
+
+ printf("{\"mode\": \"%s\", \"sessions\": %ld, \"commands\": %lu, "
+        "\"seconds\": %.6f, \"throughput\": %.0f, "
+        "\"latency_ns\": {\"p50\": %llu, \"p99\": %llu, \"p999\": %llu, "
+        "\"max\": %llu}, ",
+        Socket_Path ? "server" : "in_process", Sessions, Latency_Count,
+        Seconds, Seconds > 0 ? Latency_Count / Seconds : 0,
+        (unsigned long long) Load_Percentile(0.50),
+        (unsigned long long) Load_Percentile(0.99),
+        (unsigned long long) Load_Percentile(0.999),
+        (unsigned long long) Latency_Max);
+
+ if (Session_Bytes >= 0)
+   printf("\"memory_per_session_bytes\": %ld, ", Session_Bytes);
+ else printf("\"memory_per_session_bytes\": null, ");
+
+ printf("\"errors\": %lu}\n", Errors);
+
+ free(Players);
+ free(Games);
+ return Errors ? EXIT_FAILURE : 0;
+}
+
+
+/*--------------------
+//Function Definitions (Implementation)
+--------------------*/
+
+
+/*FUNCTION:*/
+uint64_t Load_Now(void)
+{
+ struct timespec Time;
+
+
+ clock_gettime(CLOCK_MONOTONIC, &Time);
+ return (uint64_t) Time.tv_sec * 1000000000 + Time.tv_nsec;
+}
+
+
+/*FUNCTION:*/
+const char *Load_Next_Command(struct Load_Player *Player)
+{
+ /*Scripts are played round & round, random commands come from xorshift64*/
+
+ uint64_t x = Player->Random;
+
+
+ if (Script_Lines)
+ {
+  Player->Random = (x + 1) % Script_Lines;
+  return Script[x];
+ }
+
+ x ^= x << 13;
+ x ^= x >> 7;
+ x ^= x << 17;
+ Player->Random = x;
+ return Random_Commands[x >> 60];
+}
+
+
+/*FUNCTION:*/
+void Load_Record(uint64_t Latency)
+{
+ /*Values below 16 have a bucket each, above that every power of 2 is split
+   in 16 buckets*/
+
+ int Exponent, Bucket;
+
+
+ if (Latency < 16)
+   Bucket = (int) Latency;
+ else
+ {
+  Exponent = 63 - __builtin_clzll(Latency);
+  Bucket   = (Exponent - 3) * 16 + (int) ((Latency >> (Exponent - 4)) & 15);
+ }
+
+ Latency_Histogram[Bucket]++;
+ Latency_Count++;
+ if (Latency > Latency_Max) Latency_Max = Latency;
+}
+
+
+/*FUNCTION:*/
+uint64_t Load_Percentile(double Fraction)
+{
+ /*Upper end of the bucket holding the Fraction-th latency, no more than
+   the largest latency measured*/
+
+ unsigned long Seen = 0,
+               Rank = (unsigned long) (Fraction * Latency_Count + 0.999999);
+ int           Bucket, Exponent;
+ uint64_t      Upper;
+
+
+ if (Latency_Count == 0) return 0;
+ if (Rank < 1) Rank = 1;
+
+ for (Bucket = 0; Bucket < LOAD_BUCKETS; Bucket++)
+ {
+  Seen += Latency_Histogram[Bucket];
+  if (Seen >= Rank) break;
+ }
+
+ if (Bucket < 16) return Bucket;
+
+ Exponent = Bucket / 16 + 3;
+ Upper    = ((uint64_t) (16 + Bucket % 16 + 1) << (Exponent - 4)) - 1;
+ return Upper < Latency_Max ? Upper : Latency_Max;
+}
+
+
+/*FUNCTION:*/
+long Load_Resident_Bytes(long Pid)
+{
+ /*VmRSS of process Pid, 0 for this one. Returns -1 when it cannot be read*/
+
+ char  Path[64], Line[128];
+ long  Kilobytes = -1;
+ FILE *fp;
+
+
+ if (Pid) sprintf(Path, "/proc/%ld/status", Pid);
+ else strcpy(Path, "/proc/self/status");
+
+ fp = fopen(Path, "r");
+ if (fp == NULL) return -1;
+
+ while (fgets(Line, sizeof(Line), fp))
+   if (sscanf(Line, "VmRSS: %ld kB", &Kilobytes) == 1)
+     break;
+
+ fclose(fp);
+ return Kilobytes < 0 ? -1 : Kilobytes * 1024;
+}
+
+
+/*FUNCTION:*/
+int Load_Read_Script(const char *Path)
+{
+ /*1 command per line, blank lines are skipped. Returns 0 when the file
+   cannot be read or holds no command*/
+
+ char  Line[LOAD_LINE_BYTES];
+ FILE *fp = fopen(Path, "r");
+
+
+ if (fp == NULL) return 0;
+
+ while (Script_Lines < LOAD_SCRIPT_LINES && fgets(Line, sizeof(Line), fp))
+ {
+  Line[strcspn(Line, "\r\n")] = '\0';
+  if (Line[0] != '\0')
+    Script[Script_Lines++] = strdup(Line);
+ }
+
+ fclose(fp);
+ if (Script_Lines == 0) errno = EINVAL;
+ return Script_Lines > 0;
+}
+
+
+/*FUNCTION:*/
+void Load_In_Process(struct Load_Player *Players, struct Peg_Session *Games,
+                     long Sessions, unsigned long Commands)
+{
+ /*Round robin over the players so every session stays in use, the way a
+   server sees them*/
+
+ char          Reply[SESSION_REPLY_BYTES];
+ const char   *Command;
+ unsigned long Round;
+ long          Index;
+ uint64_t      Start;
+
+
+ for (Round = 0; Round < Commands; Round++)
+    for (Index = 0; Index < Sessions; Index++)
+    {
+     Command = Load_Next_Command(&Players[Index]);
+     Start   = Load_Now();
+     Session_Command(&Games[Index], Command, strlen(Command), Reply);
+     Load_Record(Load_Now() - Start);
+    }
+}
+
+
+/*FUNCTION:*/
+int Load_Server(struct Load_Player *Players, long Sessions,
+                unsigned long Commands, int Depth, const char *Path,
+                long Server_Pid, long *Session_Bytes)
+{
+ /*Connects every player, then keeps Depth commands in flight on each until
+   all have had their replies. Returns 0 when the server cannot be reached,
+   a connection lost later counts as an error*/
+
+ struct sockaddr_un Address;
+ struct epoll_event Event, Events[LOAD_EVENTS];
+ struct Load_Player *Player;
+ char               Bytes[LOAD_DEPTH_MAX * LOAD_LINE_BYTES + 1],
+                    Reply[SESSION_REPLY_BYTES * 4];
+ const char        *Command;
+ long               Index, Before = -1, Active = Sessions;
+ ssize_t            Length, Byte;
+ size_t             Out;
+ int                Epoll_Fd, Count, Ready;
+ uint64_t           Now;
+
+
+ memset(&Address, 0, sizeof(Address));
+ Address.sun_family = AF_UNIX;
+ strncpy(Address.sun_path, Path, sizeof(Address.sun_path) - 1);
+
+ Epoll_Fd = epoll_create1(0);
+ if (Epoll_Fd < 0) return 0;
+ if (Server_Pid) Before = Load_Resident_Bytes(Server_Pid);
+
+ for (Index = 0; Index < Sessions; Index++)
+ {
+  Player     = &Players[Index];
+  Player->Fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (Player->Fd < 0 ||
+      connect(Player->Fd, (struct sockaddr *) &Address, sizeof(Address)) < 0)
+    return 0;
+
+  Event.events   = EPOLLIN;
+  Event.data.ptr = Player;
+  epoll_ctl(Epoll_Fd, EPOLL_CTL_ADD, Player->Fd, &Event);
+ }
+
+ /*1 board query per player so the server has taken every connection*/
+ for (Index = 0; Index < Sessions; Index++)
+ {
+  if (write(Players[Index].Fd, "board\n", 6) != 6 ||
+      read(Players[Index].Fd, Reply, sizeof(Reply)) <= 0)
+    return 0;
+ }
+
+ if (Before > 0)
+   *Session_Bytes = (Load_Resident_Bytes(Server_Pid) - Before) / Sessions;
+
+ for (Index = 0; Index < Sessions; Index++)
+ {
+  Player = &Players[Index];
+  Now    = Load_Now();
+  for (Out = 0; Player->Sent < Commands && Player->Sent < (unsigned) Depth;
+       Player->Sent++)
+  {
+   Command = Load_Next_Command(Player);
+   Out    += sprintf(Bytes + Out, "%s\n", Command);
+   Player->Sent_Time[Player->Sent % Depth] = Now;
+  }
+  if (Out && write(Player->Fd, Bytes, Out) != (ssize_t) Out) Errors++;
+  if (Commands == 0) Active--;
+ }
+
+ while (Active > 0)
+ {
+  Count = epoll_wait(Epoll_Fd, Events, LOAD_EVENTS, -1);
+  if (Count < 0 && errno == EINTR) continue;
+
+  for (Ready = 0; Ready < Count; Ready++)
+  {
+   Player = Events[Ready].data.ptr;
+   Length = read(Player->Fd, Reply, sizeof(Reply));
+   if (Length <= 0)
+   {
+    Errors++;
+    Active--;
+    close(Player->Fd);
+    continue;
+   }
+
+   /*Every newline is the reply to the oldest command in flight, each one
+     answered makes room for the next*/
+   Now = Load_Now();
+   Out = 0;
+   for (Byte = 0; Byte < Length; Byte++)
+   {
+    if (Reply[Byte] != '\n') continue;
+
+    Load_Record(Now - Player->Sent_Time[Player->Received % Depth]);
+    if (++Player->Received == Commands)
+    {
+     Active--;
+     close(Player->Fd);
+     break;
+    }
+
+    if (Player->Sent < Commands)
+    {
+     Command = Load_Next_Command(Player);
+     Out    += sprintf(Bytes + Out, "%s\n", Command);
+     Player->Sent_Time[Player->Sent++ % Depth] = Now;
+    }
+   }
+
+   if (Out && write(Player->Fd, Bytes, Out) != (ssize_t) Out) Errors++;
+  }
+ }
+
+ close(Epoll_Fd);
+ return 1;
+}
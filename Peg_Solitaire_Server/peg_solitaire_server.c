@@ -0,0 +1,360 @@
+/*Date:    17Oct2026Sat 16:45
+//File:    peg_solitaire_server.c
+//Desc:    Hosts any number of Peg Solitaire games in 1 process. Every client
+           of a local Unix domain socket is 1 player with its own game, it
+           sends command lines & gets 1 reply line per command, see
+           ../Peg_Engine/peg_session.h for the protocol. 1 thread serves all
+           clients from an epoll loop; a client costs 56 bytes while its
+           replies fit the socket buffer, a client that stops reading gets
+           its unsent replies buffered & is not read from until they are out.
+
+
+           To compile with gcc command:
+            gcc -Wall -Werror -Wextra -Wunused -O2 peg_solitaire_server.c ../Peg_Engine/peg_engine.c ../Peg_Engine/peg_command.c ../Peg_Engine/peg_session.c -o peg_solitaire_server
+           To run: ./peg_solitaire_server /tmp/peg_solitaire.sock
+           To play: printf 'up\nselect\ndown\ndown\nselect\n' | nc -U /tmp/peg_solitaire.sock
+           Stop with ctrl c or SIGTERM, the socket file is removed.
+*/
+
+
+/*----------------
+//Macro Defintions
+----------------*/
+#define _GNU_SOURCE /*accept4*/
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../Peg_Engine/peg_session.h"
+
+#define SERVER_EVENTS     256  /*epoll events taken per wait*/
+#define SERVER_READ_BYTES 4096 /*bytes read from a client per event*/
+#define SERVER_LINE_BYTES 11   /*longest command line kept*/
+#define SERVER_LINE_LONG  255  /*Line_Length of a line that did not fit*/
+
+
+/*-------------------------
+//Data Structure Defintions (struct, enum union)
+-------------------------*/
+struct Server_Client
+{
+ struct Peg_Session Session;
+ char              *Pending;        /*replies the socket did not take yet*/
+ unsigned int       Pending_Length;
+ unsigned char      Line_Length;    /*SERVER_LINE_LONG until the newline*/
+ char               Line[SERVER_LINE_BYTES];
+};
+
+
+/*----------------------------
+//Global Variable Declarations
+----------------------------*/
+struct Server_Client *Clients = NULL; /*indexed by socket descriptor*/
+
+int Client_Capacity = 0,
+    Epoll_Fd;
+
+unsigned long Clients_Connected = 0,
+              Clients_Served    = 0,
+              Commands_Served   = 0;
+
+volatile sig_atomic_t Server_Stop = 0;
+
+
+/*---------------------
+//Function Declarations (prototypes)
+---------------------*/
+void Server_Stop_Handler(int Signal);
+int  Server_Listen(const char *Path);
+void Server_Accept(int Listen_Fd);
+void Server_Read(int Fd);
+void Server_Send(int Fd, const char *Bytes, size_t Length);
+void Server_Flush(int Fd);
+void Server_Close(int Fd);
+
+
+/*------------
+//Main Program
+------------*/
+int main(int argc, char *argv[])
+{
+ struct epoll_event Events[SERVER_EVENTS];
+ struct sigaction   Stop;
+ int                Listen_Fd, Count, Event;
+
+
+ if (argc != 2)
+ {
+  printf("Usage: %s SOCKET_PATH\n", argv[0]);
+  return EXIT_FAILURE;
+ }
+
+ /*No SA_RESTART, the signal has to wake epoll_wait*/
+ memset(&Stop, 0, sizeof(Stop));
+ Stop.sa_handler = Server_Stop_Handler;
+ sigemptyset(&Stop.sa_mask);
+ sigaction(SIGINT,  &Stop, NULL);
+ sigaction(SIGTERM, &Stop, NULL);
+ signal(SIGPIPE, SIG_IGN);
+
+ Listen_Fd = Server_Listen(argv[1]);
+ if (Listen_Fd < 0)
+ {
+  perror(argv[1]);
+  return EXIT_FAILURE;
+ }
+
+ while (!Server_Stop)
+ {
+  Count = epoll_wait(Epoll_Fd, Events, SERVER_EVENTS, -1);
+
+  for (Event = 0; Event < Count; Event++)
+  {
+   if (Events[Event].data.fd == Listen_Fd)
+     Server_Accept(Listen_Fd);
+   else if (Events[Event].events & EPOLLOUT)
+     Server_Flush(Events[Event].data.fd);
+   else if (Events[Event].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+     Server_Read(Events[Event].data.fd);
+  }
+ }
+
+ fprintf(stderr, "clients %lu commands %lu\n", Clients_Served,
+         Commands_Served);
+ close(Listen_Fd);
+ unlink(argv[1]);
+ return 0;
+}
+
+
+/*--------------------
+//Function Definitions (Implementation)
+--------------------*/
+
+
+/*FUNCTION:*/
+void Server_Stop_Handler(int Signal)
+{
+ (void) Signal;
+ Server_Stop = 1;
+}
+
+
+/*FUNCTION:*/
+int Server_Listen(const char *Path)
+{
+ /*Returns the listening socket, or -1 with errno set. A socket file left
+   by an earlier run is replaced*/
+
+ struct sockaddr_un Address;
+ struct epoll_event Event;
+ int                Fd;
+
+
+ if (strlen(Path) >= sizeof(Address.sun_path))
+ {
+  errno = ENAMETOOLONG;
+  return -1;
+ }
+
+ memset(&Address, 0, sizeof(Address));
+ Address.sun_family = AF_UNIX;
+ strcpy(Address.sun_path, Path);
+ unlink(Path);
+
+ Fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+ if (Fd < 0 ||
+     bind(Fd, (struct sockaddr *) &Address, sizeof(Address)) < 0 ||
+     listen(Fd, SOMAXCONN) < 0)
+   return -1;
+
+ Epoll_Fd      = epoll_create1(EPOLL_CLOEXEC);
+ Event.events  = EPOLLIN;
+ Event.data.fd = Fd;
+ if (Epoll_Fd < 0 || epoll_ctl(Epoll_Fd, EPOLL_CTL_ADD, Fd, &Event) < 0)
+   return -1;
+
+ return Fd;
+}
+
+
+/*FUNCTION:*/
+void Server_Accept(int Listen_Fd)
+{
+ /*Takes every waiting connection, each starts a new game*/
+
+ struct epoll_event    Event;
+ struct Server_Client *Grown;
+ int                   Fd, Capacity;
+
+
+ while ((Fd = accept4(Listen_Fd, NULL, NULL,
+                      SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+ {
+  if (Fd >= Client_Capacity)
+  {
+   Capacity = Client_Capacity ? Client_Capacity : 1024;
+   while (Capacity <= Fd) Capacity *= 2;
+
+   Grown = realloc(Clients, Capacity * sizeof(struct Server_Client));
+   if (Grown == NULL)
+   {
+    close(Fd);
+    continue;
+   }
+
+   Clients         = Grown;
+   Client_Capacity = Capacity;
+  }
+
+  memset(&Clients[Fd], 0, sizeof(struct Server_Client));
+  Session_Init(&Clients[Fd].Session);
+
+  Event.events  = EPOLLIN;
+  Event.data.fd = Fd;
+  if (epoll_ctl(Epoll_Fd, EPOLL_CTL_ADD, Fd, &Event) < 0)
+  {
+   close(Fd);
+   continue;
+  }
+
+  Clients_Connected++;
+  Clients_Served++;
+ }
+}
+
+
+/*FUNCTION:*/
+void Server_Read(int Fd)
+{
+ /*Runs every complete line of 1 read & sends all their replies at once.
+   Bytes after the last newline wait in Line for the next read*/
+
+ static char           Replies[SERVER_READ_BYTES * SESSION_REPLY_BYTES];
+ char                  Bytes[SERVER_READ_BYTES];
+ struct Server_Client *Client = &Clients[Fd];
+ size_t                Replies_Length = 0;
+ ssize_t               Length, Byte;
+
+
+ Length = read(Fd, Bytes, sizeof(Bytes));
+ if (Length == 0 || (Length < 0 && errno != EAGAIN && errno != EINTR))
+ {
+  Server_Close(Fd);
+  return;
+ }
+
+ for (Byte = 0; Byte < Length; Byte++)
+ {
+  if (Bytes[Byte] != '\n')
+  {
+   if (Client->Line_Length < SERVER_LINE_BYTES)
+     Client->Line[Client->Line_Length++] = Bytes[Byte];
+   else Client->Line_Length = SERVER_LINE_LONG;
+   continue;
+  }
+
+  /*A line too long for any command is answered as an unknown command*/
+  if (Client->Line_Length == SERVER_LINE_LONG)
+    Client->Line_Length = 0;
+
+  Replies_Length += Session_Command(&Client->Session, Client->Line,
+                                    Client->Line_Length,
+                                    Replies + Replies_Length);
+  Client->Line_Length = 0;
+  Commands_Served++;
+ }
+
+ if (Replies_Length > 0)
+   Server_Send(Fd, Replies, Replies_Length);
+}
+
+
+/*FUNCTION:*/
+void Server_Send(int Fd, const char *Bytes, size_t Length)
+{
+ /*What the socket does not take is kept & the client is only watched for
+   room to write until it has all been sent, which stops reading from a
+   client that does not read its replies*/
+
+ struct Server_Client *Client = &Clients[Fd];
+ struct epoll_event    Event;
+ ssize_t               Sent;
+
+
+ Sent = send(Fd, Bytes, Length, MSG_NOSIGNAL);
+ if (Sent < 0 && errno != EAGAIN)
+ {
+  Server_Close(Fd);
+  return;
+ }
+
+ if (Sent < 0) Sent = 0;
+ if ((size_t) Sent == Length)
+   return;
+
+ Client->Pending = malloc(Length - Sent);
+ if (Client->Pending == NULL)
+ {
+  Server_Close(Fd);
+  return;
+ }
+
+ memcpy(Client->Pending, Bytes + Sent, Length - Sent);
+ Client->Pending_Length = Length - Sent;
+
+ Event.events  = EPOLLOUT;
+ Event.data.fd = Fd;
+ epoll_ctl(Epoll_Fd, EPOLL_CTL_MOD, Fd, &Event);
+}
+
+
+/*FUNCTION:*/
+void Server_Flush(int Fd)
+{
+ /*The socket has room again for the replies kept by Server_Send*/
+
+ struct Server_Client *Client = &Clients[Fd];
+ struct epoll_event    Event;
+ ssize_t               Sent;
+
+
+ Sent = send(Fd, Client->Pending, Client->Pending_Length, MSG_NOSIGNAL);
+ if (Sent < 0 && errno != EAGAIN)
+ {
+  Server_Close(Fd);
+  return;
+ }
+
+ if (Sent < 0) Sent = 0;
+ Client->Pending_Length -= Sent;
+ if (Client->Pending_Length > 0)
+ {
+  memmove(Client->Pending, Client->Pending + Sent, Client->Pending_Length);
+  return;
+ }
+
+ free(Client->Pending);
+ Client->Pending = NULL;
+
+ Event.events  = EPOLLIN;
+ Event.data.fd = Fd;
+ epoll_ctl(Epoll_Fd, EPOLL_CTL_MOD, Fd, &Event);
+}
+
+
+/*FUNCTION:*/
+void Server_Close(int Fd)
+{
+ /*Closing the descriptor also takes it out of the epoll set*/
+
+ free(Clients[Fd].Pending);
+ Clients[Fd].Pending = NULL;
+ close(Fd);
+ Clients_Connected--;
+}
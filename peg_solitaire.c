@@ -1,5 +1,5 @@
 /*Date:    31Mar2013Sun 20:44
-//Updated: 14Nov2024Thu 18:25:45
+//Updated: 18Oct2026Sun 02:14:05
 //File:    peg_solitaire.c
 //Author:  Ashraf
 //Email:   ashraf.allie01@gmail.com
@@ -16,23 +16,110 @@
            MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
 
-           To run with tcc command: tcc -run peg_solitaire.c
+           To run with tcc command: tcc -pthread Peg_Engine/peg_engine.c Peg_Engine/peg_command.c Peg_Engine/peg_game.c Peg_Engine/peg_solver.c Peg_Engine/peg_database.c Peg_Engine/peg_rank.c Peg_Engine/peg_pagoda.c Peg_Engine/peg_save.c Peg_Engine/peg_journal.c Peg_Engine/peg_large.c Peg_Engine/peg_count.c -run peg_solitaire.c
            To compile with gcc command:
-            gcc -Wall -Werror -Wextra -Wunused peg_solitaire.c -o peg_solitaire
+            gcc -Wall -Werror -Wextra -Wunused -pthread peg_solitaire.c Peg_Engine/peg_engine.c Peg_Engine/peg_command.c Peg_Engine/peg_game.c Peg_Engine/peg_solver.c Peg_Engine/peg_database.c Peg_Engine/peg_rank.c Peg_Engine/peg_pagoda.c Peg_Engine/peg_save.c Peg_Engine/peg_journal.c Peg_Engine/peg_large.c Peg_Engine/peg_count.c -o peg_solitaire
+           or against the engine library (see Peg_Engine/peg_game.h):
+            gcc -Wall -Werror -Wextra -Wunused peg_solitaire.c -LPeg_Engine -lpeg_engine -pthread -o peg_solitaire
            To run the executable: ./peg_solitaire
+           Options: --threads N   search hints with N threads (default 1)
+                    --analyze     no game, reads positions from stdin & for
+                                  each writes 1 line to stdout:
+                                  packed solvable pegs mobility best
+                    --binary      with --analyze or --count, positions are 8
+                                  byte little endian packed boards instead
+                                  of text lines
+                    --limit N     with --analyze, give up on a position after
+                                  N nodes per search (default 20000, 0 for
+                                  no limit), with --count after N counted
+                                  positions
+                    --count       no game, like --analyze but each line is
+                                  the packed board & the number of jump
+                                  sequences that finish on the centre (-1
+                                  gave up, a + after 2^128 - 1 means at
+                                  least that many), counted with --threads
+                                  N, see Peg_Engine/peg_count.h
+                    --database FILE
+                                  answer solve & --analyze from the endgame
+                                  database FILE wherever it covers the board
+                    --meet N      solve & --analyze search from both ends,
+                                  forward from the board & backward from
+                                  the finish, meeting at boards of N beads
+                                  (0 lets the search pick), see Solver_Meet
+                    --record FILE journals every command of the game to
+                                  FILE, see Peg_Engine/peg_journal.h
+                    --replay FILE no prompt, plays the commands of the
+                                  journal FILE again at full speed without
+                                  drawing & checks the board it ends on
+                    --pace        with --replay, draws every frame & keeps
+                                  the pace the commands were typed at
+                    --size N      play on the N x N cross instead, N odd
+                                  from 7 to 33, drawn as a viewport that
+                                  scrolls with the cursor. Only play, no
+                                  solve, undo, save or load. A journal
+                                  recorded with it replays with the same
+                                  --size, see Peg_Engine/peg_large.h
+                    --check-meet  no game, reads positions like --analyze &
+                                  solves each with the depth first & the
+                                  meet in the middle solver (--meet N, 0
+                                  by default) within --limit N nodes, each
+                                  board they disagree on is written out
+                                  with both answers & the exit status is
+                                  then 1
+                    --build-database FILE
+                                  no game, writes the endgame database of
+                                  boards of up to --pegs N beads (default 9,
+                                  about 150 MB) to FILE, see
+                                  Peg_Engine/peg_database.h
+
+           Add -DPEG_GEOMETRY=GEOMETRY_ENGLISH (or _EUROPEAN, _TRIANGLE) to
+           play on another board, see Peg_Engine/peg_geometry.h.
+
+           Add -DPEG_STATS Peg_Engine/peg_stats.c to the gcc command for
+           timers around input, dispatch, rules, screen composition &
+           output, reported to stderr on quit & on SIGUSR1, see
+           Peg_Engine/peg_stats.h.
+
+           Analyze input lines are either BOARD_HOLES characters (45 on the
+           cross), the holes row by row with X or 1 for a bead & . or 0 for
+           an empty hole, or the packed board as up to 12 hex digits (see
+           Bitboard_Pack). Blank lines & lines starting with # are skipped.
+           Output fields: packed board in hex, solvable 1 / 0 / -1 (gave up),
+           beads left, legal jumps & the most jumps still possible (-1 gave
+           up). Example:
+            echo 0000060180f8 | ./peg_solitaire --analyze
+            0000060180f8 1 9 9 8
 */
 
 
 /*----------------
 //Macro Defintions
 ----------------*/
+#include <errno.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
-
-#define BUFFER 9
+#include "Peg_Engine/peg_engine.h"
+#include "Peg_Engine/peg_command.h"
+#include "Peg_Engine/peg_game.h"
+#include "Peg_Engine/peg_solver.h"
+#include "Peg_Engine/peg_database.h"
+#include "Peg_Engine/peg_save.h"
+#include "Peg_Engine/peg_stats.h"
+#include "Peg_Engine/peg_journal.h"
+#include "Peg_Engine/peg_large.h"
+#include "Peg_Engine/peg_count.h"
+
+#define SOLVE_NODE_LIMIT 20000000 /*roughly 30 seconds of searching*/
+#define COUNT_NODE_LIMIT 10000000 /*roughly 30 seconds of counting*/
+#define ANALYZE_NODE_LIMIT 20000   /*default of --limit*/
+#define ANALYZE_BATCH      4096    /*positions read before they are analyzed*/
+#define FRAME_BYTES        4096    /*a full redraw is about 1.6 KB*/
+#define FRAME_GAP          8       /*unchanged cells worth rewriting rather
+                                     than jumping over with an escape*/
 
 
 /*-------------------------
@@ -44,19 +131,38 @@ enum WindowType {Main, Menu, Info};
 /*----------------------------
 //Global Variable Declarations
 ----------------------------*/
-int board[9][9],
-    beads,
-    Current_Board_Row,
-    Current_Board_Col,
-    Selected_Bead_Row,
-    Selected_Bead_Col,
-    Screen_Rows,
+struct Peg_Game Game; /*board, cursor, selection & undo log, see
+                        Peg_Engine/peg_game.h*/
+
+int Screen_Rows,
     Screen_Cols,
     HighlightedMenuOption = 1,
-    Valid_Bead_Hop = 0;
+    Valid_Bead_Hop = 0,
+    Solver_Threads = 1,
+    Meet_Pegs      = -1; /*--meet, -1 for the depth first solver*/
+
+unsigned long Analyze_Node_Limit = ANALYZE_NODE_LIMIT;
+
+struct Peg_Journal Journal;   /*--record or --replay, see
+                                Peg_Engine/peg_journal.h*/
+int                Recording    = 0,
+                   Replaying    = 0,
+                   Replay_Paced = 0; /*--pace, else no rendering*/
+
+enum Peg_Command Entered_Command = Command_Error; /*set by Command_Line*/
+
+struct Large_Geometry Large;          /*--size, see Peg_Engine/peg_large.h*/
+struct Large_Game     Large_Play;     /*the game on it*/
+int                   Large_Size = 0; /*0 for the board built for*/
 
-char Entered_Command[BUFFER];
 char Screen[24][66];
+char Shown_Screen[24][66]; /*the frame the terminal shows, see Display_Screen*/
+
+int Term_Rows,         /*rows of the terminal, the prompt scrolls below 23*/
+    Term_Is_Tty,       /*0 when stdout is a file or pipe, no escapes then*/
+    Screen_Shown = 0;  /*0 until a full frame is out, next frame redraws*/
+
+volatile sig_atomic_t Term_Resized = 0; /*set by SIGWINCH*/
 
 enum WindowType CurrentWindow = Main;
 
@@ -70,24 +176,147 @@ void Board_Initialization(void);
 void ScreenBorderSetup(void);
 void MainMenu(unsigned char HighlightedChoice);
 void Display_Screen(void);
+void Term_Resize_Handler(int Signal);
+void Term_Restore(void);
 void Peg_Solitaire_Board(void);
 void Status_Window(void);
 void Info_Window(unsigned char Msg);
 void Command_Line(void);
 void Board_Cursor(void);
+void Large_Board_Window(void);
+int  Large_Board_Command(void);
+void Large_Select(void);
+uint64_t Board_Key(void);
 void Bead_Manager(void);
+void Solve_Hint(void);
+void Count_Hint(void);
+void Undo_Jump(void);
+void Redo_Jump(void);
 void Save_Game(void);
 void Load_Game(void);
-void Input(char *string_ptr, size_t num_characters);
+size_t Input(char *string_ptr, size_t num_characters);
+enum Peg_Command Replay_Command(void);
+int  Replay_Verify(uint64_t Started);
+int  Analyze_Positions(int Binary);
+int  Analyze_Read(int Binary, unsigned long *Line, struct Bitboard *Board);
+int  Count_Positions(int Binary);
+int  Check_Meet(int Binary);
+int  Build_Database(const char *Path, int Pegs);
 
 
 /*------------
 //Main Program
 ------------*/
-int main(void)
+int main(int argc, char *argv[])
 {
- Splash_Screen();
- Term_Screen_Size_Detection();
+ const char *Database_Path = NULL,
+            *Build_Path    = NULL,
+            *Record_Path   = NULL,
+            *Replay_Path   = NULL;
+ int         Arg, Analyze = 0, Count = 0, Check = 0, Binary = 0,
+             Database_Pegs = DATABASE_PEGS;
+ uint64_t    Started;
+
+
+ for (Arg = 1; Arg < argc; Arg++)
+ {
+  if (strcmp(argv[Arg], "--threads") == 0 && Arg + 1 < argc)
+    Solver_Threads = atoi(argv[++Arg]);
+  else if (strcmp(argv[Arg], "--analyze") == 0)
+    Analyze = 1;
+  else if (strcmp(argv[Arg], "--count") == 0)
+    Count = 1;
+  else if (strcmp(argv[Arg], "--check-meet") == 0)
+    Check = 1;
+  else if (strcmp(argv[Arg], "--binary") == 0)
+    Binary = 1;
+  else if (strcmp(argv[Arg], "--limit") == 0 && Arg + 1 < argc)
+    Analyze_Node_Limit = strtoul(argv[++Arg], NULL, 10);
+  else if (strcmp(argv[Arg], "--database") == 0 && Arg + 1 < argc)
+    Database_Path = argv[++Arg];
+  else if (strcmp(argv[Arg], "--build-database") == 0 && Arg + 1 < argc)
+    Build_Path = argv[++Arg];
+  else if (strcmp(argv[Arg], "--pegs") == 0 && Arg + 1 < argc)
+    Database_Pegs = atoi(argv[++Arg]);
+  else if (strcmp(argv[Arg], "--meet") == 0 && Arg + 1 < argc)
+    Meet_Pegs = atoi(argv[++Arg]);
+  else if (strcmp(argv[Arg], "--record") == 0 && Arg + 1 < argc)
+    Record_Path = argv[++Arg];
+  else if (strcmp(argv[Arg], "--replay") == 0 && Arg + 1 < argc)
+    Replay_Path = argv[++Arg];
+  else if (strcmp(argv[Arg], "--pace") == 0)
+    Replay_Paced = 1;
+  else if (strcmp(argv[Arg], "--size") == 0 && Arg + 1 < argc)
+    Large_Size = atoi(argv[++Arg]);
+  else
+  {
+   printf("Usage: %s [--threads N] [--database FILE] [--meet N] "
+          "[--record FILE | --replay FILE [--pace]] [--size N] "
+          "[--analyze | --count | --check-meet [--binary] [--limit N]] "
+          "[--build-database FILE [--pegs N]]\n", argv[0]);
+   return EXIT_FAILURE;
+  }
+ }
+
+ if (Solver_Threads < 1) Solver_Threads = 1;
+
+ if (Large_Size && !Large_Init(&Large, Large_Size))
+ {
+  printf("Error --size must be odd & from %d to %d\n", LARGE_MIN_SIZE,
+         LARGE_MAX_SIZE);
+  return EXIT_FAILURE;
+ }
+
+ if (Build_Path)
+   return Build_Database(Build_Path, Database_Pegs);
+
+ if (Database_Path && !Database_Open(Database_Path))
+ {
+  printf("Error %s is not an endgame database\n", Database_Path);
+  return EXIT_FAILURE;
+ }
+
+ /*Batch mode skips the splash screen & all rendering*/
+ if (Analyze)
+   return Analyze_Positions(Binary);
+
+ if (Count)
+   return Count_Positions(Binary);
+
+ if (Check)
+   return Check_Meet(Binary);
+
+ if (Replay_Path)
+ {
+  if (!Journal_Open(&Journal, Replay_Path) || Journal.Kind != Journal_Commands)
+  {
+   printf("Error %s is not a journal of commands\n", Replay_Path);
+   return EXIT_FAILURE;
+  }
+  Replaying = 1;
+ }
+ else if (Record_Path)
+ {
+  if (!Journal_Create(&Journal, Record_Path, Journal_Commands))
+  {
+   printf("Error cannot write %s\n", Record_Path);
+   return EXIT_FAILURE;
+  }
+  Recording = 1;
+ }
+
+ STATS_INIT();
+ Started = Journal_Clock();
+
+ /*A replay at full speed draws into the Screen array but never sends it,
+   so it needs no terminal*/
+ if (!Replaying) Splash_Screen();
+ if (Replaying && !Replay_Paced)
+ {
+  Screen_Rows = 24;
+  Screen_Cols = 66;
+ }
+ else Term_Screen_Size_Detection();
  Board_Initialization();
  ScreenBorderSetup();
  Status_Window();
@@ -97,12 +326,30 @@ int main(void)
  Info_Window(0);
  Display_Screen();
 
+ /*The pace starts at the first prompt, not while the splash screen waits*/
+ Journal.Last = Journal_Clock();
+
  do
  {
+  STATS_BEGIN(Stats_Dispatch);
   Command_Line();
+  STATS_END(Stats_Dispatch);
   Display_Screen();
+  STATS_POLL();
  }
- while (strcmp(Entered_Command, "quit"));
+ while (Entered_Command != Command_Quit);
+
+ Term_Restore();
+ STATS_REPORT();
+
+ if (Recording && !Journal_Close(&Journal, Board_Key()))
+ {
+  printf("Error the journal %s is incomplete\n", Record_Path);
+  return EXIT_FAILURE;
+ }
+
+ if (Replaying)
+   return Replay_Verify(Started);
 
  return 0;
 }
@@ -131,7 +378,8 @@ void Splash_Screen(void)
 /*FUNCTION:*/
 void Term_Screen_Size_Detection(void)
 {
- struct winsize w;
+ struct winsize   w;
+ struct sigaction Resize;
  ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
 
 
@@ -147,48 +395,30 @@ void Term_Screen_Size_Detection(void)
 
   exit(EXIT_FAILURE);
  }
+
+ Term_Rows   = w.ws_row;
+ Term_Is_Tty = isatty(STDOUT_FILENO);
+
+ /*A resize only sets a flag, the next frame is then redrawn in full. With
+   SA_RESTART the fgets waiting for a command is not cut short*/
+ memset(&Resize, 0, sizeof(Resize));
+ Resize.sa_handler = Term_Resize_Handler;
+ Resize.sa_flags   = SA_RESTART;
+ sigemptyset(&Resize.sa_mask);
+ sigaction(SIGWINCH, &Resize, NULL);
 }
 
 
 /*FUNCTION:*/
 void Board_Initialization(void)
 {
- unsigned char board_row, board_col;
-
-
- beads             = 44;
- Current_Board_Row = 4;
- Current_Board_Col = 4;
- Selected_Bead_Row = 'N',
- Selected_Bead_Col = 'N';
-
- /*Initializing the 4 non used 3x3 blocks to NULL (N)*/
- for (board_row = 0; board_row <= 2; board_row++)
-    for (board_col = 0; board_col <= 2; board_col++)
-    {
-     board[board_row][board_col] = 'N';
-     board[8 - board_row][board_col] = 'N';
-     board[board_row][8 - board_col] = 'N';
-     board[8 - board_row][8 - board_col] = 'N';
-    }
-
- /*Initialize all remaining blocks to beads represented by (X)*/
- for (board_row = 0; board_row <= 2; board_row++)
-    for (board_col = 3; board_col <= 5; board_col++)
-    {
-     board[board_row][board_col] = 'X';     /*Top 3x3 block*/
-     board[board_col][board_row] = 'X';     /*Left 3x3 block*/
-     board[8 - board_row][board_col] = 'X'; /*Bottom 3x3 block*/
-     board[board_col][8 - board_row] = 'X'; /*Right 3x3 block*/
-     board[board_row + 3][board_col] = 'X'; /*Central 3x3 block*/
-                                      /*Note the central element block is set!*/
-    }
+ /*Every hole of the board holds a bead (X) except 1, the central hole of
+   the cross*/
+ Game_Init(&Game);
 
- /*Uninitialize the central block represented by a space*/
- board[Current_Board_Row][Current_Board_Col] = ' ';
+ if (Large_Size) Large_Game_Init(&Large, &Large_Play);
 }
 
-
 /*FUNCTION:*/
 void ScreenBorderSetup(void)
 {
@@ -252,6 +482,8 @@ void MainMenu(unsigned char HighlightedChoice)
  };
 
 
+ STATS_BEGIN(Stats_Compose);
+
  /*Copies Main Menu into Screen Array*/
  for (Menu_Row = 0; Menu_Row <= 6; Menu_Row++)
  {
@@ -271,17 +503,119 @@ void MainMenu(unsigned char HighlightedChoice)
     Screen[Menu_Row + 1 + line_space_and_menu_shift_down][Screen_Cols - 18 + Menu_Col] = ']';
  }
 
+ STATS_END(Stats_Compose);
 }
 
 
 /*FUNCTION:*/
 void Display_Screen(void)
 {
- unsigned char Row;
+ /*Sends only what changed since the last frame: each run of changed cells
+   is an ANSI cursor move followed by the new characters, runs closer than
+   FRAME_GAP are joined & the whole frame goes out in 1 write. The first
+   frame, a frame after a resize & every frame on a terminal with no room
+   below the screen (the prompt then scrolls the screen) clear & redraw all.
+   Output that is not a terminal gets plain lines as before*/
+
+ static char    Frame[FRAME_BYTES];
+ struct winsize w;
+ size_t         Length = 0, Sent = 0;
+ ssize_t        Written;
+ unsigned char  Row, Col, Run_Start, Run_End;
 
 
- for (Row = 0; Row < Screen_Rows - 1; Row++)
-    printf("%s\n", Screen[Row]);
+ if (Replaying && !Replay_Paced) return;
+
+ if (!Term_Is_Tty)
+ {
+  STATS_BEGIN(Stats_Output);
+  for (Row = 0; Row < Screen_Rows - 1; Row++)
+     printf("%s\n", Screen[Row]);
+  STATS_END(Stats_Output);
+  return;
+ }
+
+ /*"Command: " from the last prompt must not land in the middle of the frame*/
+ fflush(stdout);
+
+ STATS_BEGIN(Stats_Compose);
+
+ if (Term_Resized || !Screen_Shown || Term_Rows <= Screen_Rows)
+ {
+  Term_Resized = 0;
+  if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) == 0) Term_Rows = w.ws_row;
+
+  /*Only the rows below the screen scroll, the scroll region needs 2*/
+  if (Term_Rows > Screen_Rows)
+    Length += sprintf(Frame + Length, "\033[%d;%dr", Screen_Rows, Term_Rows);
+
+  Length += sprintf(Frame + Length, "\033[H\033[2J");
+  for (Row = 0; Row < Screen_Rows - 1; Row++)
+     Length += sprintf(Frame + Length, "%s\r\n", Screen[Row]);
+
+  memcpy(Shown_Screen, Screen, sizeof(Screen));
+  Screen_Shown = 1;
+ }
+ else
+ {
+  for (Row = 0; Row < Screen_Rows - 1; Row++)
+  {
+   Col = 0;
+   while (Col < Screen_Cols - 1)
+   {
+    if (Screen[Row][Col] == Shown_Screen[Row][Col])
+    {
+     Col++;
+     continue;
+    }
+
+    /*Extend the run over later changes up to FRAME_GAP cells apart*/
+    Run_Start = Run_End = Col;
+    for (Col++; Col < Screen_Cols - 1 && Col - Run_End <= FRAME_GAP; Col++)
+       if (Screen[Row][Col] != Shown_Screen[Row][Col]) Run_End = Col;
+
+    Length += sprintf(Frame + Length, "\033[%d;%dH", Row + 1, Run_Start + 1);
+    memcpy(Frame + Length, &Screen[Row][Run_Start], Run_End - Run_Start + 1);
+    memcpy(&Shown_Screen[Row][Run_Start], &Screen[Row][Run_Start],
+           Run_End - Run_Start + 1);
+    Length += Run_End - Run_Start + 1;
+    Col     = Run_End + 1;
+   }
+  }
+ }
+
+ /*Prompt row cleared of the last command, the cursor left there*/
+ Length += sprintf(Frame + Length, "\033[%d;1H\033[J", Screen_Rows);
+ STATS_END(Stats_Compose);
+
+ STATS_BEGIN(Stats_Output);
+ while (Sent < Length)
+ {
+  Written = write(STDOUT_FILENO, Frame + Sent, Length - Sent);
+  if (Written < 0 && errno == EINTR) continue;
+  if (Written <= 0) break;
+  Sent += Written;
+ }
+ STATS_END(Stats_Output);
+}
+
+
+/*FUNCTION:*/
+void Term_Resize_Handler(int Signal)
+{
+ (void) Signal;
+ Term_Resized = 1;
+}
+
+
+/*FUNCTION:*/
+void Term_Restore(void)
+{
+ /*Scroll region back to the whole terminal, the shell prompt goes on the
+   row of the game prompt*/
+
+ if (Term_Is_Tty)
+   printf("\033[r\033[%d;1H", Screen_Rows);
 }
 
 
@@ -289,34 +623,20 @@ void Display_Screen(void)
 void Peg_Solitaire_Board(void)
 {
  unsigned char Game_Board_Row, Game_Board_Col;
- char          *Game_Board[] =
+ const char    *const *Game_Board = Board_Picture; /*of the board built for*/
+
+
+ if (Large_Size)
  {
-  "    0   1   2   3   4   5   6   7   8",
-  "              +---+---+---+",
-  "0             |   |   |   |             0",
-  "              +---+---+---+",
-  "1             |   |   |   |             1",
-  "              +---+---+---+",
-  "2             |   |   |   |             2",
-  "  +---+---+---+---+---+---+---+---+---+",
-  "3 |   |   |   |   |   |   |   |   |   | 3",
-  "  +---+---+---+---+---+---+---+---+---+",
-  "4 |   |   |   |   |   |   |   |   |   | 4",
-  "  +---+---+---+---+---+---+---+---+---+",
-  "5 |   |   |   |   |   |   |   |   |   | 5",
-  "  +---+---+---+---+---+---+---+---+---+",
-  "6             |   |   |   |             6",
-  "              +---+---+---+",
-  "7             |   |   |   |             7",
-  "              +---+---+---+",
-  "8             |   |   |   |             8",
-  "              +---+---+---+",
-  "    0   1   2   3   4   5   6   7   8"
- };
+  Large_Board_Window();
+  return;
+ }
 
+ STATS_BEGIN(Stats_Compose);
 
 /*Writes the Game_Board & the board beads to Screen Array*/
-for (Game_Board_Row = 0; Game_Board_Row < 21; Game_Board_Row++)
+for (Game_Board_Row = 0; Game_Board_Row < BOARD_PICTURE_LINES;
+     Game_Board_Row++)
    for (Game_Board_Col = 0; Game_Board[Game_Board_Row][Game_Board_Col] != '\0';
         Game_Board_Col++)
    {
@@ -327,13 +647,15 @@ for (Game_Board_Row = 0; Game_Board_Row < 21; Game_Board_Row++)
       if ((Game_Board_Col % 4) == 0 && (Game_Board_Col / 4) != 0)
         if ((Game_Board_Row / 2) - 1 <= 8 && (Game_Board_Col / 4) - 1 <= 8)
         {
-          if (board[(Game_Board_Row / 2) - 1][(Game_Board_Col / 4) - 1] == 'N')
-            Screen[Game_Board_Row + 1][Game_Board_Col + 3] = ' ';
+          if (Bitboard_Test(Game.Pegs, HOLE_INDEX((Game_Board_Row / 2) - 1,
+                                             (Game_Board_Col / 4) - 1)))
+            Screen[Game_Board_Row + 1][Game_Board_Col + 3] = 'X';
           else
-              Screen[Game_Board_Row + 1][Game_Board_Col + 3] =
-                      board[(Game_Board_Row / 2) - 1][(Game_Board_Col / 4) - 1];
+              Screen[Game_Board_Row + 1][Game_Board_Col + 3] = ' ';
         }
    }
+
+ STATS_END(Stats_Compose);
 }
 
 
@@ -341,6 +663,8 @@ for (Game_Board_Row = 0; Game_Board_Row < 21; Game_Board_Row++)
 void Status_Window(void)
 {
  unsigned char Col;
+ int           Cursor_Row = Large_Size ? Large_Play.Cursor_Row : Game.Cursor_Row,
+               Cursor_Col = Large_Size ? Large_Play.Cursor_Col : Game.Cursor_Col;
  char          *Status[] =
  {
   "Window: Main",
@@ -351,6 +675,8 @@ void Status_Window(void)
  };
 
 
+ STATS_BEGIN(Stats_Compose);
+
  switch (CurrentWindow)
  {
   case Main:
@@ -386,13 +712,22 @@ void Status_Window(void)
         Screen[Screen_Rows - 4][Screen_Cols - 18 + Col] = Status[4][Col];
        }
 
-       Screen[Screen_Rows - 5][Screen_Cols - 13] = Current_Board_Row + 48;
-       Screen[Screen_Rows - 4][Screen_Cols - 13] = Current_Board_Col + 48;
+       /*2 digits on a --size board*/
+       Screen[Screen_Rows - 5][Screen_Cols - 13] = Cursor_Row < 10 ?
+                                    Cursor_Row + 48 : Cursor_Row / 10 + 48;
+       Screen[Screen_Rows - 5][Screen_Cols - 12] = Cursor_Row < 10 ?
+                                    ' '             : Cursor_Row % 10 + 48;
+       Screen[Screen_Rows - 4][Screen_Cols - 13] = Cursor_Col < 10 ?
+                                    Cursor_Col + 48 : Cursor_Col / 10 + 48;
+       Screen[Screen_Rows - 4][Screen_Cols - 12] = Cursor_Col < 10 ?
+                                    ' '             : Cursor_Col % 10 + 48;
   break;
  }
 
  for (Col = 0; Status[CurrentWindow][Col] != '\0' ; Col++)
     Screen[Screen_Rows - 3][Screen_Cols - 18 + Col] = Status[CurrentWindow][Col];
+
+ STATS_END(Stats_Compose);
 }
 
 
@@ -405,7 +740,7 @@ void Info_Window(unsigned char Msg)
   "Info:",
   "Error invalid  command. Type  \"help\" to list commands",
   "Options 1 to 6 only work in   the menu window",
-  "Commands: up   down right leftselect tab quithelp main menu info new load  save settings",
+  "settings selectup new tab quitdown right lefthelp main menu info undo redo load save solvecount",
   "New Game       initialized",
   "Settings       feature not    implemented",
   "For the menu   window use     commands up    down and the   numbers 1 to 6",
@@ -417,12 +752,23 @@ void Info_Window(unsigned char Msg)
   "Congratulationsyou have solvedthe puzzle",
   "Game saved",
   "Game loaded",
-  "Error game not loaded"
+  "Error game not loaded",
+  "Solvable, hint:jump from  ,   to  ,",
+  "Not solvable   from here",
+  "Solver gave up too many jumps  to explore",
+  "Nothing to undo",
+  "Nothing to redo",
+  "Error game not saved",
+  "Not available  on a --size    board",
+  "Solutions:",
+  "Counting gave  up too many    positions"
  };
 
 
- /*Clear Info area*/
- for (Row = 12; Row <= 17; Row++)
+ STATS_BEGIN(Stats_Compose);
+
+ /*Clear Info area, the line under Info: too*/
+ for (Row = 11; Row <= 17; Row++)
     for (Col = Screen_Cols - 18; Col <= Screen_Cols - 4; Col++)
        Screen[Row][Col] = ' ';
 
@@ -451,6 +797,19 @@ void Info_Window(unsigned char Msg)
   case 13:
   case 14:
   case 15:
+  case 16:
+  case 17:
+  case 18:
+  case 19:
+  case 20:
+  case 21:
+  case 22:
+  case 23:
+  case 24:
+       /*The command list of help is 7 lines, it starts on the line under
+         Info:*/
+       if (Msg == 3) Row = 10;
+
        for (Col = 0; Info[Msg][Col] != '\0'; Col++)
        {
         if (Col % 15 == 0) Row++;
@@ -459,73 +818,69 @@ void Info_Window(unsigned char Msg)
 
   break;
  }
+
+ STATS_END(Stats_Compose);
 }
 
 
 /*FUNCTION:*/
 void Command_Line(void)
 {
- char *Command_List[] =
- {
-  /* 0*/ "menu",
-  /* 1*/ "1",
-  /* 2*/ "2",
-  /* 3*/ "3",
-  /* 4*/ "4",
-  /* 5*/ "5",
-  /* 6*/ "6",
-  /* 7*/ "up",
-  /* 8*/ "down",
-  /* 9*/ "right",
-  /*10*/ "left",
-  /*11*/ "select",
-  /*12*/ "tab",
-  /*13*/ "help",
-  /*14*/ "quit",
-  /*15*/ "main",
-  /*16*/ "info",
-  /*17*/ "new",
-  /*18*/ "load",
-  /*19*/ "save",
-  /*20*/ "settings"
- };
+ /*1 line, longer ones than any command are read whole & are errors*/
 
- unsigned char Command_Index;
+ char     Line[COMMAND_LONGEST + 2];
+ size_t   Length;
+ uint64_t Token;
 
 
  Info_Window(0);
- printf("Command: ");
- Input(Entered_Command, BUFFER);
- for (Command_Index = 0; Command_Index <= 20; Command_Index++)
+
+ if (Replaying)
+   Entered_Command = Replay_Command();
+ else
  {
-  if (strcmp(Command_List[Command_Index], Entered_Command) == 0)
-  {
-   break;
-  }
+  printf("Command: ");
+  STATS_BEGIN(Stats_Input);
+  Length = Input(Line, sizeof(Line));
+  STATS_END(Stats_Input);
+  Entered_Command = Length == 0 && feof(stdin) ? Command_Quit
+                                              : Command_Token(Line, Length);
  }
 
- switch (Command_Index)
+ /*The token is journaled, not the line, so aliases & typos replay alike*/
+ if (Recording)
+ {
+  Token = (uint64_t) Entered_Command;
+  Journal_Write(&Journal, &Token, 1);
+ }
+
+ /*--size: the cursor & the beads are on the large board, the windows work
+   as always*/
+ if (Large_Size && Large_Board_Command())
+   return;
+
+ switch (Entered_Command)
  {
   /*menu*/
-  case  0:
+  case Command_Menu:
         CurrentWindow = Main;
         Status_Window();
   break;
 
 
   /*menu options 1 to 6*/
-  case 1:
-  case 2:
-  case 3:
-  case 4:
-  case 5:
-  case 6:
+  case Command_Option_1:
+  case Command_Option_2:
+  case Command_Option_3:
+  case Command_Option_4:
+  case Command_Option_5:
+  case Command_Option_6:
        if (CurrentWindow == Menu)
        {
-        HighlightedMenuOption = Command_Index;
+        HighlightedMenuOption = Entered_Command - Command_Option_1 + 1;
         MainMenu(HighlightedMenuOption);
 
-        switch (Command_Index)
+        switch (HighlightedMenuOption)
         {
          case 1: Info_Window(3);
          break;
@@ -552,7 +907,7 @@ void Command_Line(void)
          break;
 
 
-         case 6: strcpy(Entered_Command, (char *) Command_List[14]);
+         case 6: Entered_Command = Command_Quit;
          break;
         }
        }
@@ -562,24 +917,11 @@ void Command_Line(void)
 
 
   /*up*/
-  case  7:
+  case Command_Up:
         switch (CurrentWindow)
         {
          case Main:
-              if ( (Current_Board_Row == 0) &&
-                  ((Current_Board_Col >= 3) && (Current_Board_Col <= 5))
-                 )
-                Current_Board_Row = 8;
-
-              else if (  (Current_Board_Row == 3) &&
-                       (((Current_Board_Col >= 0) && (Current_Board_Col <= 2)) ||
-                        ((Current_Board_Col >= 6) && (Current_Board_Col <= 8))
-                       )
-                      )
-                     Current_Board_Row = 5;
-
-              else Current_Board_Row--;
-
+              Game_Move_Cursor(&Game, -1, 0);
 
               Board_Cursor();
               CurrentWindow = Info;
@@ -601,23 +943,11 @@ void Command_Line(void)
 
 
   /*down*/
-  case  8:
+  case Command_Down:
         switch (CurrentWindow)
         {
          case Main:
-              if ((Current_Board_Row == 8) &&
-                  ((Current_Board_Col >= 3) && (Current_Board_Col <= 5))
-                 )
-                Current_Board_Row = 0;
-
-              else if (  (Current_Board_Row == 5) &&
-                       (((Current_Board_Col >= 0) && (Current_Board_Col <= 2)) ||
-                        ((Current_Board_Col >= 6) && (Current_Board_Col <= 8))
-                       )
-                      )
-                     Current_Board_Row = 3;
-
-              else Current_Board_Row++;
+              Game_Move_Cursor(&Game, 1, 0);
 
               Board_Cursor();
               CurrentWindow = Info;
@@ -640,22 +970,10 @@ void Command_Line(void)
 
 
   /*right*/
-  case  9:
+  case Command_Right:
         if (CurrentWindow == Main)
         {
-         if ( (Current_Board_Col == 8) &&
-             ((Current_Board_Row >= 3) && (Current_Board_Row <= 5)
-             )
-            )
-           Current_Board_Col = 0;
-         else if (  (Current_Board_Col == 5) &&
-                  (((Current_Board_Row >= 0) && (Current_Board_Row <= 2)) ||
-                   ((Current_Board_Row >= 6) && (Current_Board_Row <= 8))
-                  )
-                 )
-                Current_Board_Col = 3;
-
-         else Current_Board_Col++;
+         Game_Move_Cursor(&Game, 0, 1);
 
          Board_Cursor();
          CurrentWindow = Info;
@@ -667,23 +985,10 @@ void Command_Line(void)
 
 
   /*left*/
-  case 10:
+  case Command_Left:
        if (CurrentWindow == Main)
        {
-        if ( (Current_Board_Col == 0) &&
-            ((Current_Board_Row >= 3) && (Current_Board_Row <= 5)
-            )
-           )
-          Current_Board_Col = 8;
-
-        else if (  (Current_Board_Col == 3) &&
-                 (((Current_Board_Row >= 0) && (Current_Board_Row <= 2)) ||
-                  ((Current_Board_Row >= 6) && (Current_Board_Row <= 8))
-                 )
-                )
-               Current_Board_Col = 5;
-
-        else Current_Board_Col--;
+        Game_Move_Cursor(&Game, 0, -1);
 
         Board_Cursor();
         CurrentWindow = Info;
@@ -695,43 +1000,43 @@ void Command_Line(void)
 
 
   /*select*/
-  case 11:
+  case Command_Select:
        switch (CurrentWindow)
        {
         case Main:
-             if (board[Current_Board_Row][Current_Board_Col] == ' ' &&
-                 Selected_Bead_Row == 'N' && Selected_Bead_Col == 'N'
+             if (!Bitboard_Test(Game.Pegs, HOLE_INDEX(Game.Cursor_Row, Game.Cursor_Col)) &&
+                 Game.Selected_Row == GAME_NONE && Game.Selected_Col == GAME_NONE
                 )
                /*Empty block*/
                Info_Window(9);
-             else if (board[Current_Board_Row][Current_Board_Col] == ' ' &&
-                      Selected_Bead_Row != 'N' && Selected_Bead_Col != 'N'
+             else if (!Bitboard_Test(Game.Pegs, HOLE_INDEX(Game.Cursor_Row, Game.Cursor_Col)) &&
+                      Game.Selected_Row != GAME_NONE && Game.Selected_Col != GAME_NONE
                      )
                     /*Do calculations for valid hop*/
                     Bead_Manager();
-             else if (board[Current_Board_Row][Current_Board_Col] == 'X' &&
-                      Selected_Bead_Row == 'N' && Selected_Bead_Col == 'N'
+             else if (Bitboard_Test(Game.Pegs, HOLE_INDEX(Game.Cursor_Row, Game.Cursor_Col)) &&
+                      Game.Selected_Row == GAME_NONE && Game.Selected_Col == GAME_NONE
                      )
              {
               /*Selects a bead*/
-              Selected_Bead_Row = Current_Board_Row;
-              Selected_Bead_Col = Current_Board_Col;
+              Game.Selected_Row = Game.Cursor_Row;
+              Game.Selected_Col = Game.Cursor_Col;
               Info_Window(7);
              }
-             else if (board[Current_Board_Row][Current_Board_Col] == 'X' &&
-                      Selected_Bead_Row == Current_Board_Row &&
-                      Selected_Bead_Col == Current_Board_Col
+             else if (Bitboard_Test(Game.Pegs, HOLE_INDEX(Game.Cursor_Row, Game.Cursor_Col)) &&
+                      Game.Selected_Row == Game.Cursor_Row &&
+                      Game.Selected_Col == Game.Cursor_Col
                      )
              {
               /*Deselects a bead & clears bead cursor*/
               Board_Cursor();
-              Selected_Bead_Row = 'N';
-              Selected_Bead_Col = 'N';
+              Game.Selected_Row = GAME_NONE;
+              Game.Selected_Col = GAME_NONE;
               Board_Cursor();
               Info_Window(8);
              }
-             else if (board[Current_Board_Row][Current_Board_Col] == 'X' &&
-                      Selected_Bead_Row != 'N' && Selected_Bead_Col != 'N'
+             else if (Bitboard_Test(Game.Pegs, HOLE_INDEX(Game.Cursor_Row, Game.Cursor_Col)) &&
+                      Game.Selected_Row != GAME_NONE && Game.Selected_Col != GAME_NONE
                      )
              {
               /*Cannot select another bead*/
@@ -768,7 +1073,7 @@ void Command_Line(void)
               break;
 
 
-              case 6: strcpy(Entered_Command, (char *) Command_List[14]);
+              case 6: Entered_Command = Command_Quit;
               break;
              }
         break;
@@ -781,58 +1086,81 @@ void Command_Line(void)
 
 
   /*tab*/
-  case 12: Status_Window();
+  case Command_Tab: Status_Window();
   break;
 
 
   /*help*/
-  case 13: Info_Window(3);
+  case Command_Help: Info_Window(3);
   break;
 
 
   /*quit*/
-  case 14: MainMenu(6);
+  case Command_Quit: MainMenu(6);
   break;
 
 
   /*main*/
-  case 15: CurrentWindow = Info;
-           Status_Window();
+  case Command_Main:
+       CurrentWindow = Info;
+       Status_Window();
   break;
 
 
   /*info*/
-  case 16: CurrentWindow = Menu;
-           Status_Window();
+  case Command_Info:
+       CurrentWindow = Menu;
+       Status_Window();
   break;
 
 
   /*new*/
-  case 17: Board_Initialization(); /*Resets the boards beads*/
-           Peg_Solitaire_Board();  /*Writes to Screen array*/
-           Board_Cursor();
-           CurrentWindow = Info;
-           Status_Window();
+  case Command_New:
+       Board_Initialization(); /*Resets the boards beads*/
+       Peg_Solitaire_Board();  /*Writes to Screen array*/
+       Board_Cursor();
+       CurrentWindow = Info;
+       Status_Window();
   break;
 
 
   /*load*/
-  case 18: Load_Game();
+  case Command_Load: Load_Game();
   break;
 
 
   /*save*/
-  case 19: Save_Game();
+  case Command_Save: Save_Game();
   break;
 
 
   /*settings*/
-  case 20: Info_Window(5);
+  case Command_Settings: Info_Window(5);
+  break;
+
+
+  /*solve*/
+  case Command_Solve: Solve_Hint();
+  break;
+
+
+  /*undo*/
+  case Command_Undo: Undo_Jump();
+  break;
+
+
+  /*redo*/
+  case Command_Redo: Redo_Jump();
+  break;
+
+
+  /*count*/
+  case Command_Count: Count_Hint();
   break;
 
 
   /*Error message display*/
-  case 21: Info_Window(1);
+  default: Info_Window(1);
   break;
  }
 }
@@ -841,154 +1169,48 @@ void Command_Line(void)
 /*FUNCTION:*/
 void Board_Cursor(void)
 {
- /*Clears previous cursor position*/
- /*up command*/
- if (strcmp(Entered_Command, "up") == 0)
- {
-  if (Current_Board_Row == 8)
-  {
-   /*Clear board row 0*/
-   Current_Board_Row = 0;
-   Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 6] = ' ';
-   Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 8] = ' ';
-   Current_Board_Row = 8;
-  }
-  else if (  (Current_Board_Row == 5) &&
-           (
-            ((Current_Board_Col >= 0) && (Current_Board_Col <= 2)) ||
-            ((Current_Board_Col >= 6) && (Current_Board_Col <= 8))
-           )
-          )
-  {
-   /*Clear board row 3*/
-   Current_Board_Row = 3;
-   Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 6] = ' ';
-   Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 8] = ' ';
-   Current_Board_Row = 5;
-  }
-  else
-  {
-   /*Clear the previous cursor position*/
-   Screen[(Current_Board_Row + 1) * 2 + 3][Current_Board_Col * 4 + 6] = ' ';
-   Screen[(Current_Board_Row + 1) * 2 + 3][Current_Board_Col * 4 + 8] = ' ';
-  }
- }
+ unsigned char Row, Col;
 
- /*down command*/
- else if (strcmp(Entered_Command, "down") == 0)
- {
-  if (Current_Board_Row == 0)
-  {
-   /*Clear board row 8*/
-   Current_Board_Row = 8;
-   Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 6] = ' ';
-   Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 8] = ' ';
-   Current_Board_Row = 0;
-  }
-  else if ( (Current_Board_Row == 3) &&
-           (
-            ((Current_Board_Col >= 0) && (Current_Board_Col <= 2)) ||
-            ((Current_Board_Col >= 6) && (Current_Board_Col <= 8))
-           )
-          )
-  {
-   /*Clear board row 5*/
-   Current_Board_Row = 5;
-   Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 6] = ' ';
-   Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 8] = ' ';
-   Current_Board_Row = 3;
-  }
-  else
-  {
-   /*Clear the previous cursor position*/
-   Screen[(Current_Board_Row - 1) * 2 + 3][Current_Board_Col * 4 + 6] = ' ';
-   Screen[(Current_Board_Row - 1) * 2 + 3][Current_Board_Col * 4 + 8] = ' ';
-  }
- }
 
- /*right command*/
- else if (strcmp(Entered_Command, "right") == 0)
+ if (Large_Size)
  {
-  if (Current_Board_Col == 0)
-  {
-   /*Clear board column 8*/
-   Current_Board_Col = 8;
-   Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 6] = ' ';
-   Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 8] = ' ';
-   Current_Board_Col = 0;
-  }
-  else if (  (Current_Board_Col == 3) &&
-           (
-            ((Current_Board_Row >= 0) && (Current_Board_Row <= 2)) ||
-            ((Current_Board_Row >= 6) && (Current_Board_Row <= 8))
-           )
-          )
-  {
-   /*Clear board column 5*/
-   Current_Board_Col = 5;
-   Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 6] = ' ';
-   Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 8] = ' ';
-   Current_Board_Col = 3;
-  }
-  else
-  {
-   /*Clear the previous cursor position*/
-   Screen[Current_Board_Row * 2 + 3][(Current_Board_Col - 1) * 4 + 6] = ' ';
-   Screen[Current_Board_Row * 2 + 3][(Current_Board_Col - 1) * 4 + 8] = ' ';
-  }
+  Large_Board_Window();
+  return;
  }
 
- /*left command*/
- else if (strcmp(Entered_Command, "left") == 0)
- {
-  if (Current_Board_Col == 8)
-  {
-   /*Clear board column 0*/
-   Current_Board_Col = 0;
-   Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 6] = ' ';
-   Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 8] = ' ';
-   Current_Board_Col = 8;
-  }
-  else if (  (Current_Board_Col == 5) &&
-           (
-            ((Current_Board_Row >= 0) && (Current_Board_Row <= 2)) ||
-            ((Current_Board_Row >= 6) && (Current_Board_Row <= 8))
-           )
-          )
-  {
-   /*Clear board column 3*/
-   Current_Board_Col = 3;
-   Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 6] = ' ';
-   Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 8] = ' ';
-   Current_Board_Col = 5;
-  }
-  else
-  {
-   /*Clear the previous cursor position*/
-   Screen[Current_Board_Row * 2 + 3][(Current_Board_Col + 1) * 4 + 6] = ' ';
-   Screen[Current_Board_Row * 2 + 3][(Current_Board_Col + 1) * 4 + 8] = ' ';
-  }
- }
+ STATS_BEGIN(Stats_Compose);
+
+ /*Clears the cursor from every hole, wherever it was before. The selected
+   bead's cursor is written again below*/
+ for (Row = 0; Row < BOARD_SIZE; Row++)
+    for (Col = 0; Col < BOARD_SIZE; Col++)
+       if (Bitboard_Test(Valid_Holes, HOLE_INDEX(Row, Col)))
+       {
+        Screen[Row * 2 + 3][Col * 4 + 6] = ' ';
+        Screen[Row * 2 + 3][Col * 4 + 8] = ' ';
+       }
 
 
  /*Writes new cursor position*/
- Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 6] = '[';
- Screen[Current_Board_Row * 2 + 3][Current_Board_Col * 4 + 8] = ']';
+ Screen[Game.Cursor_Row * 2 + 3][Game.Cursor_Col * 4 + 6] = '[';
+ Screen[Game.Cursor_Row * 2 + 3][Game.Cursor_Col * 4 + 8] = ']';
 
  /*Writes selected bead's cursor position*/
- if (Selected_Bead_Row != 'N' && Selected_Bead_Col != 'N')
+ if (Game.Selected_Row != GAME_NONE && Game.Selected_Col != GAME_NONE)
  {
-  Screen[Selected_Bead_Row * 2 + 3][Selected_Bead_Col * 4 + 6] = '[';
-  Screen[Selected_Bead_Row * 2 + 3][Selected_Bead_Col * 4 + 8] = ']';
+  Screen[Game.Selected_Row * 2 + 3][Game.Selected_Col * 4 + 6] = '[';
+  Screen[Game.Selected_Row * 2 + 3][Game.Selected_Col * 4 + 8] = ']';
  }
 
  if (Valid_Bead_Hop)
  {
   /*Clears the selected bead cursor after a valid hop*/
-  Screen[Selected_Bead_Row * 2 + 3][Selected_Bead_Col * 4 + 6] = ' ';
-  Screen[Selected_Bead_Row * 2 + 3][Selected_Bead_Col * 4 + 8] = ' ';
+  Screen[Game.Selected_Row * 2 + 3][Game.Selected_Col * 4 + 6] = ' ';
+  Screen[Game.Selected_Row * 2 + 3][Game.Selected_Col * 4 + 8] = ' ';
   Valid_Bead_Hop = 0;
  }
+
+ STATS_END(Stats_Compose);
 }
 
 
@@ -996,144 +1218,345 @@ void Board_Cursor(void)
 void Bead_Manager(void)
 {
  /*The Bead_Manager will validate correct & incorrect bead moves, keeps track of
-   total amount of beads left, writes to the board array*/
+   total amount of beads left, writes to the board bitboard. Game_Apply does
+   the validation, toggles the from, over & to holes in one XOR & logs the
+   jump for undo*/
 
- if (Selected_Bead_Row != 'N' &&
-     board[Current_Board_Row][Current_Board_Col] == ' ')
+ STATS_BEGIN(Stats_Rules);
+
+ if (Game.Selected_Row != GAME_NONE &&
+     Game_Apply(&Game, HOLE_INDEX(Game.Selected_Row, Game.Selected_Col),
+                       HOLE_INDEX(Game.Cursor_Row, Game.Cursor_Col)))
  {
-  if (Current_Board_Col == Selected_Bead_Col)
-  {
-   if (((Current_Board_Row > Selected_Bead_Row) &&
-        (Current_Board_Row - Selected_Bead_Row == 2)) ||
-       ((Selected_Bead_Row > Current_Board_Row) &&
-        (Selected_Bead_Row - Current_Board_Row == 2))
-      )
-     if (board[(Current_Board_Row + Selected_Bead_Row) / 2][Current_Board_Col]
-                                                                         == 'X')
-     {
-      /*Erase the 2 beads & write the 1 bead*/
-      board[Selected_Bead_Row][Selected_Bead_Col] = ' ';
-      board[(Current_Board_Row + Selected_Bead_Row) / 2][Current_Board_Col]
-                                                                          = ' ';
-      board[Current_Board_Row][Current_Board_Col] = 'X';
-      Peg_Solitaire_Board();
-      Valid_Bead_Hop = 1;
-      Board_Cursor();
-      Selected_Bead_Row = 'N';
-      Selected_Bead_Col = 'N';
-      Board_Cursor();
-      if (beads > 1) beads--;
-      Info_Window(10);
-      Screen[12][Screen_Cols - 6] = beads / 10 + 48;
-      Screen[12][Screen_Cols - 5] = beads % 10 + 48;
-
-     }
-  }
-  else if (Current_Board_Row == Selected_Bead_Row)
+  Peg_Solitaire_Board();
+  Valid_Bead_Hop = 1;
+  Board_Cursor();
+  Game.Selected_Row = GAME_NONE;
+  Game.Selected_Col = GAME_NONE;
+  Board_Cursor();
+  Info_Window(10);
+  Screen[12][Screen_Cols - 6] = Game.Beads / 10 + 48;
+  Screen[12][Screen_Cols - 5] = Game.Beads % 10 + 48;
+ }
+
+ if (Game_Is_Won(&Game))
+   Info_Window(12);
+
+ STATS_END(Stats_Rules);
+}
+
+
+/*FUNCTION:*/
+void Large_Board_Window(void)
+{
+ /*--size: the viewport of the large board with its cursor & selection in
+   place of Peg_Solitaire_Board & Board_Cursor, drawn whole every time. The
+   frame only sends what changed, see Display_Screen*/
+
+ static char   Picture[LARGE_VIEW_LINES][LARGE_VIEW_WIDTH + 1];
+ unsigned char Row;
+
+
+ STATS_BEGIN(Stats_Compose);
+
+ Large_Render(&Large, &Large_Play, Picture);
+ for (Row = 0; Row < LARGE_VIEW_LINES; Row++)
+    memcpy(&Screen[Row + 1][1], Picture[Row], LARGE_VIEW_WIDTH);
+
+ STATS_END(Stats_Compose);
+}
+
+
+/*FUNCTION:*/
+int Large_Board_Command(void)
+{
+ /*--size: the commands of the Main window that move the cursor or a bead.
+   Returns 0 for every other command, Command_Line then runs it as usual*/
+
+ if (CurrentWindow != Main) return 0;
+
+ switch (Entered_Command)
+ {
+  case Command_Up:    Large_Move_Cursor(&Large, &Large_Play, -1,  0);
+  break;
+
+
+  case Command_Down:  Large_Move_Cursor(&Large, &Large_Play,  1,  0);
+  break;
+
+
+  case Command_Left:  Large_Move_Cursor(&Large, &Large_Play,  0, -1);
+  break;
+
+
+  case Command_Right: Large_Move_Cursor(&Large, &Large_Play,  0,  1);
+  break;
+
+
+  case Command_Select:
+       Large_Select();
+       Large_Board_Window();
+  return 1;
+
+
+  default: return 0;
+ }
+
+ Large_Board_Window();
+ CurrentWindow = Info;
+ Status_Window();
+ return 1;
+}
+
+
+/*FUNCTION:*/
+void Large_Select(void)
+{
+ /*The select command of the Main window on a --size board, the same cases
+   as on the board built for. Up to 3 digits of beads left*/
+
+ int Bead = Large_Test(&Large_Play.Pegs, LARGE_INDEX(&Large,
+                                                     Large_Play.Cursor_Row,
+                                                     Large_Play.Cursor_Col));
+
+
+ STATS_BEGIN(Stats_Rules);
+
+ if (!Bead && Large_Play.Selected_Row == LARGE_NONE)
+   /*Empty block*/
+   Info_Window(9);
+ else if (!Bead)
+ {
+  if (Large_Game_Jump(&Large, &Large_Play))
   {
-   if (((Current_Board_Col > Selected_Bead_Col) &&
-        (Current_Board_Col - Selected_Bead_Col == 2)) ||
-       ((Selected_Bead_Col > Current_Board_Col) &&
-        (Selected_Bead_Col - Current_Board_Col == 2))
-      )
-     if (board[Current_Board_Row][(Current_Board_Col + Selected_Bead_Col) / 2]
-                                                                         == 'X')
-     {
-      board[Selected_Bead_Row][Selected_Bead_Col] = ' ';
-      board[Current_Board_Row][(Current_Board_Col + Selected_Bead_Col) / 2]
-                                                                          = ' ';
-      board[Current_Board_Row][Current_Board_Col] = 'X';
-      Peg_Solitaire_Board();
-      Valid_Bead_Hop = 1;
-      Board_Cursor();
-      Selected_Bead_Row = 'N';
-      Selected_Bead_Col = 'N';
-      Board_Cursor();
-      if (beads > 1) beads--;
-      Info_Window(10);
-      Screen[12][Screen_Cols - 6] = beads / 10 + 48;
-      Screen[12][Screen_Cols - 5] = beads % 10 + 48;
-     }
+   Info_Window(10);
+   Screen[12][Screen_Cols - 6] = Large_Play.Beads / 100 + 48;
+   Screen[12][Screen_Cols - 5] = Large_Play.Beads / 10 % 10 + 48;
+   Screen[12][Screen_Cols - 4] = Large_Play.Beads % 10 + 48;
   }
+
+  if (Large_Is_Won(&Large, &Large_Play.Pegs))
+    Info_Window(12);
+ }
+ else if (Large_Play.Selected_Row == LARGE_NONE)
+ {
+  /*Selects a bead*/
+  Large_Play.Selected_Row = Large_Play.Cursor_Row;
+  Large_Play.Selected_Col = Large_Play.Cursor_Col;
+  Info_Window(7);
  }
+ else if (Large_Play.Selected_Row == Large_Play.Cursor_Row &&
+          Large_Play.Selected_Col == Large_Play.Cursor_Col)
+ {
+  /*Deselects a bead*/
+  Large_Play.Selected_Row = LARGE_NONE;
+  Large_Play.Selected_Col = LARGE_NONE;
+  Info_Window(8);
+ }
+ /*Cannot select another bead*/
+ else Info_Window(11);
 
- if (beads == 1 && board[4][4] == 'X')
-   Info_Window(12);
+ STATS_END(Stats_Rules);
 }
 
 
 /*FUNCTION:*/
-void Save_Game(void)
+uint64_t Board_Key(void)
 {
- FILE *fp = NULL;
- unsigned char i,j;
- struct Saved_Data_Struct
+ /*Hash of the board being played, what a journal ends with*/
+
+ if (Large_Size) return Large_Hash(&Large, &Large_Play.Pegs);
+ return Game.Key;
+}
+
+/*FUNCTION:*/
+void Solve_Hint(void)
+{
+ /*Searches the current board for a way to finish with 1 bead in the centre &
+   shows the first jump of that solution as a hint. The last answer is kept
+   with the hash of its board, asking again before moving is not searched*/
+
+ static struct Solver_Result Result;
+ static uint64_t             Result_Key;
+ static int                  Result_Valid = 0;
+
+
+ if (Large_Size)
  {
-  int board[9][9],
-      beads,
-      Current_Board_Row,
-      Current_Board_Col,
-      Selected_Bead_Row,
-      Selected_Bead_Col;
- } Saved_Data;
+  Info_Window(22);
+  return;
+ }
 
+ if (!Result_Valid || Result_Key != Game.Key || Result.Solvable == -1)
+ {
+  if (Meet_Pegs >= 0)
+    Solver_Meet(Game.Pegs, Meet_Pegs, SOLVE_NODE_LIMIT, &Result);
+  else Solver_Solve(Game.Pegs, Solver_Threads, SOLVE_NODE_LIMIT, &Result);
 
- for (i = 0; i <= 8; i++)
-    for (j = 0; j <= 8; j++)
-       Saved_Data.board[i][j] = board[i][j];
+  Result_Key   = Game.Key;
+  Result_Valid = 1;
+ }
 
+ switch (Result.Solvable)
+ {
+  case 1:
+       /*Already won, there is no jump left to show*/
+       if (Result.Moves == 0)
+       {
+        Info_Window(12);
+        break;
+       }
+
+       Info_Window(16);
+       Screen[13][Screen_Cols - 8] = Result.Solution[0].From / BOARD_STRIDE + 48;
+       Screen[13][Screen_Cols - 6] = Result.Solution[0].From % BOARD_STRIDE + 48;
+       Screen[14][Screen_Cols - 15] = Result.Solution[0].To / BOARD_STRIDE + 48;
+       Screen[14][Screen_Cols - 13] = Result.Solution[0].To % BOARD_STRIDE + 48;
+  break;
+
+
+  case 0: Info_Window(17);
+  break;
+
+
+  default: Info_Window(18);
+  break;
+ }
+}
 
- Saved_Data.beads             = beads;
- Saved_Data.Current_Board_Row = Current_Board_Row;
- Saved_Data.Current_Board_Col = Current_Board_Col;
- Saved_Data.Selected_Bead_Row = Selected_Bead_Row;
- Saved_Data.Selected_Bead_Col = Selected_Bead_Col;
 
- fp = fopen("peg_solitaire.save", "wb");
- if (fp)
+/*FUNCTION:*/
+void Count_Hint(void)
+{
+ /*Counts the jump sequences from the current board that finish on the
+   centre & writes the number under "Solutions:", 15 digits a line. A count
+   that reached 2^128 - 1 ends in a +. The last count is kept like the last
+   hint of Solve_Hint*/
+
+ static struct Count_Result Result;
+ static uint64_t            Result_Key;
+ static int                 Result_Valid = 0;
+ char                       Text[COUNT_DIGITS + 1];
+ unsigned char              Digit;
+
+
+ if (Large_Size)
+ {
+  Info_Window(22);
+  return;
+ }
+
+ if (!Result_Valid || Result_Key != Game.Key || Result.Counted == -1)
  {
-  fwrite(&Saved_Data, sizeof(Saved_Data), 1, fp);
-  fclose(fp);
+  Count_Solutions(Game.Pegs, Solver_Threads, COUNT_NODE_LIMIT, &Result);
+
+  Result_Key   = Game.Key;
+  Result_Valid = 1;
  }
 
- Info_Window(13);
+ if (Result.Counted == -1)
+ {
+  Info_Window(24);
+  return;
+ }
+
+ Info_Window(23);
+ Count_Format(Result.Solutions, Text);
+ if (Result.Counted == 0) strcat(Text, "+");
+
+ for (Digit = 0; Text[Digit] != '\0'; Digit++)
+    Screen[13 + Digit / 15][Screen_Cols - 18 + Digit % 15] = Text[Digit];
 }
 
 
 /*FUNCTION:*/
-void Load_Game(void)
+void Undo_Jump(void)
 {
- FILE *fp = NULL;
- unsigned char i,j;
- struct Saved_Data_Struct
+ /*Takes back the last jump, it stays in the log so redo can make it again*/
+
+ if (Large_Size)
  {
-  int board[9][9],
-      beads,
-      Current_Board_Row,
-      Current_Board_Col,
-      Selected_Bead_Row,
-      Selected_Bead_Col;
- } Saved_Data;
+  Info_Window(22);
+  return;
+ }
 
+ if (!Game_Undo(&Game))
+ {
+  Info_Window(19);
+  return;
+ }
 
- fp = fopen("peg_solitaire.save", "rb");
- if (fp)
+ Game.Selected_Row = GAME_NONE;
+ Game.Selected_Col = GAME_NONE;
+ Peg_Solitaire_Board();
+ Board_Cursor();
+ Info_Window(10);
+ Screen[12][Screen_Cols - 6] = Game.Beads / 10 + 48;
+ Screen[12][Screen_Cols - 5] = Game.Beads % 10 + 48;
+}
+
+/*FUNCTION:*/
+void Redo_Jump(void)
+{
+ if (Large_Size)
  {
-  fread(&Saved_Data, sizeof(Saved_Data), 1, fp);
-  fclose(fp);
+  Info_Window(22);
+  return;
+ }
 
+ if (!Game_Redo(&Game))
+ {
+  Info_Window(20);
+  return;
+ }
 
-  for (i = 0; i <= 8; i++)
-     for (j = 0; j <= 8; j++)
-        board[i][j] = Saved_Data.board[i][j];
+ Game.Selected_Row = GAME_NONE;
+ Game.Selected_Col = GAME_NONE;
+ Peg_Solitaire_Board();
+ Board_Cursor();
+ Info_Window(10);
+ Screen[12][Screen_Cols - 6] = Game.Beads / 10 + 48;
+ Screen[12][Screen_Cols - 5] = Game.Beads % 10 + 48;
+
+ if (Game_Is_Won(&Game))
+   Info_Window(12);
+}
+
+/*FUNCTION:*/
+void Save_Game(void)
+{
+ /*Writes the versioned binary save of Peg_Engine/peg_save.h, the move log
+   included so undo & redo carry over*/
+
+ if (Large_Size)
+ {
+  Info_Window(22);
+  return;
+ }
+
+ if (Save_Write("peg_solitaire.save", &Game))
+   Info_Window(13);
+ else Info_Window(21);
+}
 
+/*FUNCTION:*/
+void Load_Game(void)
+{
+ /*Only a save that passes every check of Save_Read replaces the game, a
+   missing, old or damaged file leaves the board as it is*/
 
-  beads             = Saved_Data.beads;
-  Current_Board_Row = Saved_Data.Current_Board_Row;
-  Current_Board_Col = Saved_Data.Current_Board_Col;
-  Selected_Bead_Row = Saved_Data.Selected_Bead_Row;
-  Selected_Bead_Col = Saved_Data.Selected_Bead_Col;
+ struct Peg_Game Loaded;
 
+
+ if (Large_Size)
+ {
+  Info_Window(22);
+  return;
+ }
+
+ if (Save_Read("peg_solitaire.save", &Loaded))
+ {
+  Game = Loaded;
   Info_Window(14);
   Peg_Solitaire_Board();
   Board_Cursor();
@@ -1143,15 +1566,283 @@ void Load_Game(void)
  else Info_Window(15);
 }
 
+/*FUNCTION:*/
+size_t Input(char *string_ptr, size_t num_characters)
+{
+ /*Reads 1 line & returns its length without the newline. What does not fit
+   is skipped up to the newline & num_characters is returned, so a long line
+   cannot pass for the command it starts with*/
+
+ size_t length = 0;
+ int    c;
+
+
+ /*SIGUSR1 of PEG_STATS cuts the wait short, the report is written then*/
+ while (fgets(string_ptr, num_characters, stdin) == NULL)
+ {
+  if (!ferror(stdin) || errno != EINTR)
+    return length;
+
+  clearerr(stdin);
+  STATS_POLL();
+ }
+
+ length = strlen(string_ptr);
+
+ if (length > 0 && string_ptr[length - 1] == '\n')
+   string_ptr[--length] = '\0';
+ else if (length == num_characters - 1)
+ {
+  while ((c = getchar()) != EOF && c != '\n')
+    ;
+  length = num_characters;
+ }
+
+ return length;
+}
+
+
+/*FUNCTION:*/
+enum Peg_Command Replay_Command(void)
+{
+ /*--replay: the next command of the journal instead of a line of input,
+   waiting as long as it was typed after the one before with --pace. A
+   journal that runs out quits*/
+
+ uint64_t Delay, Values[JOURNAL_VALUES];
+ int      Count;
+
+
+ if (!Journal_Read(&Journal, &Delay, Values, &Count) ||
+     Values[0] > Command_Error)
+   return Command_Quit;
+
+ if (Replay_Paced) Journal_Wait(Journal.Last);
+
+ /*Version 1 has no count command, its error token is Command_Count now*/
+ if (Journal.Version == 1 && Values[0] == Command_Count)
+   return Command_Error;
+
+ return (enum Peg_Command) Values[0];
+}
+
+
+/*FUNCTION:*/
+int Replay_Verify(uint64_t Started)
+{
+ /*After the last command the journal must end with the key of the board
+   the replay finished on*/
+
+ double Elapsed = (Journal_Clock() - Started) / 1e3;
+ int    Same    = Journal_Verify(&Journal, Board_Key());
+
+
+ printf("replay %lu commands in %.3f ms, board %016llx %s\n",
+        Journal.Records, Elapsed, (unsigned long long) Board_Key(),
+        !Journal.Complete ? "(journal cut short, not checked)" :
+        Same ? "matches" : "differs from the recording");
+
+ return Same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 
 /*FUNCTION:*/
-void Input(char *string_ptr, size_t num_characters)
+int Analyze_Positions(int Binary)
 {
- if (fgets(string_ptr, num_characters, stdin) != NULL)
+ /*--analyze: reads positions from stdin in batches of ANALYZE_BATCH, counts
+   the legal jumps of a whole batch with 1 Bitboard_Mobility_Batch call &
+   then asks the solver about each position. The dead table carries over
+   from 1 position to the next so boards from the same game cost little*/
+
+ static struct Bitboard      Boards[ANALYZE_BATCH];
+ static unsigned char        Mobility[ANALYZE_BATCH];
+ static struct Solver_Result Result;
+ unsigned long               Line = 0;
+ int                         Count, Index, Beads, Best, More = 1;
+
+
+ setvbuf(stdout, NULL, _IOFBF, 1 << 16);
+
+ while (More)
  {
-  size_t last = strlen(string_ptr) - 1;
+  for (Count = 0; Count < ANALYZE_BATCH; Count++)
+     if (!(More = Analyze_Read(Binary, &Line, &Boards[Count])))
+       break;
+
+  Bitboard_Mobility_Batch(Boards, Count, Mobility);
 
-  if (string_ptr[last] == '\n')
-    string_ptr[last] = '\0';
+  for (Index = 0; Index < Count; Index++)
+  {
+   Beads = Bitboard_Count(Boards[Index]);
+   Best  = Solver_Longest(Boards[Index], Analyze_Node_Limit);
+
+   /*Only a position that can be played down to 1 bead can be solvable, the
+     longest line is the cheaper search & settles most boards on its own*/
+   if (Best != Beads - 1 && Best >= 0)
+     Result.Solvable = 0;
+   else if (Meet_Pegs >= 0)
+     Solver_Meet(Boards[Index], Meet_Pegs, Analyze_Node_Limit, &Result);
+   else Solver_Solve(Boards[Index], Solver_Threads, Analyze_Node_Limit,
+                     &Result);
+
+   printf("%012llx %d %d %d %d\n",
+          (unsigned long long) Bitboard_Pack(Boards[Index]),
+          Result.Solvable, Beads, Mobility[Index], Best);
+  }
  }
+
+ Solver_Free();
+ return fflush(stdout) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+/*FUNCTION:*/
+int Analyze_Read(int Binary, unsigned long *Line, struct Bitboard *Board)
+{
+ /*Next position from stdin into Board, 0 at the end of the input. Text
+   lines that are not a position are reported on stderr & skipped*/
+
+ unsigned char      Bytes[8];
+ char               Text[128], *End;
+ unsigned long long Packed;
+ size_t             Length;
+ int                Hole;
+
+
+ if (Binary)
+ {
+  if (fread(Bytes, 1, 8, stdin) != 8)
+    return 0;
+
+  for (Hole = 7, Packed = 0; Hole >= 0; Hole--)
+     Packed = Packed << 8 | Bytes[Hole];
+
+  *Board = Bitboard_Unpack(Packed & (((uint64_t) 1 << BOARD_HOLES) - 1));
+  return 1;
+ }
+
+ while (fgets(Text, sizeof(Text), stdin))
+ {
+  ++*Line;
+  Length = strcspn(Text, "\r\n");
+  Text[Length] = '\0';
+
+  if (Length == 0 || Text[0] == '#')
+    continue;
+
+  /*BOARD_HOLES holes row by row*/
+  if (Length == BOARD_HOLES &&
+      strspn(Text, "Xx1.0") == BOARD_HOLES)
+  {
+   for (Hole = BOARD_HOLES - 1, Packed = 0; Hole >= 0; Hole--)
+      Packed = Packed << 1 | (Text[Hole] == 'X' || Text[Hole] == 'x' ||
+                              Text[Hole] == '1');
+
+   *Board = Bitboard_Unpack(Packed);
+   return 1;
+  }
+
+  /*Packed board in hex*/
+  Packed = strtoull(Text, &End, 16);
+  if (End != Text && *End == '\0' && Packed >> BOARD_HOLES == 0)
+  {
+   *Board = Bitboard_Unpack(Packed);
+   return 1;
+  }
+
+  fprintf(stderr, "line %lu: not a position: %s\n", *Line, Text);
+ }
+
+ return 0;
+}
+
+
+/*FUNCTION:*/
+int Count_Positions(int Binary)
+{
+ /*--count: reads positions like --analyze & writes each packed board with
+   its number of solutions, -1 when the count gave up after --limit
+   positions. A count that reached 2^128 - 1 ends in a + like in
+   Count_Hint. The memo table carries over from 1 position to the next*/
+
+ struct Count_Result Result;
+ struct Bitboard     Board;
+ unsigned long       Line = 0;
+ char                Text[COUNT_DIGITS];
+
+
+ setvbuf(stdout, NULL, _IOFBF, 1 << 16);
+
+ while (Analyze_Read(Binary, &Line, &Board))
+ {
+  Count_Solutions(Board, Solver_Threads, Analyze_Node_Limit, &Result);
+
+  printf("%012llx %s%s\n", (unsigned long long) Bitboard_Pack(Board),
+         Result.Counted == -1 ? "-1" : Count_Format(Result.Solutions, Text),
+         Result.Counted == 0 ? "+" : "");
+ }
+
+ Count_Free();
+ return fflush(stdout) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+/*FUNCTION:*/
+int Check_Meet(int Binary)
+{
+ /*--check-meet: Solver_Meet must agree with Solver_Solve. A board either
+   solver gave up on is not compared, the last line counts the boards
+   compared & those that differ*/
+
+ static struct Solver_Result Solved, Met;
+ struct Bitboard             Board;
+ unsigned long               Line = 0, Compared = 0, Differ = 0;
+
+
+ while (Analyze_Read(Binary, &Line, &Board))
+ {
+  Solver_Solve(Board, Solver_Threads, Analyze_Node_Limit, &Solved);
+  Solver_Meet(Board, Meet_Pegs < 0 ? 0 : Meet_Pegs, Analyze_Node_Limit, &Met);
+
+  if (Solved.Solvable == -1 || Met.Solvable == -1)
+    continue;
+
+  Compared++;
+  if (Solved.Solvable != Met.Solvable)
+  {
+   Differ++;
+   printf("%012llx solve %d meet %d\n",
+          (unsigned long long) Bitboard_Pack(Board), Solved.Solvable,
+          Met.Solvable);
+  }
+ }
+
+ printf("%lu compared, %lu differ\n", Compared, Differ);
+
+ Solver_Free();
+ return Differ == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+/*FUNCTION:*/
+int Build_Database(const char *Path, int Pegs)
+{
+ /*--build-database: writes the database & lists the winnable boards of each
+   layer*/
+
+ int Beads;
+
+
+ if (!Database_Build(Path, Pegs) || !Database_Open(Path))
+ {
+  printf("Error database %s not built\n", Path);
+  return EXIT_FAILURE;
+ }
+
+ for (Beads = 1; Beads <= Database_Max_Pegs(); Beads++)
+    printf("%2d beads %10llu winnable\n", Beads,
+           (unsigned long long) Database_Winnable(Beads));
+
+ Database_Close();
+ return 0;
 }